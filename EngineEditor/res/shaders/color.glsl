@@ -7,11 +7,12 @@ layout(location = 0) in vec3 a_Position;
 
 uniform mat4 u_ViewProjection;
 uniform mat4 u_Transform;
+uniform float u_Depth;
 
 
 
 void main(){	
-	gl_Position = u_ViewProjection * u_Transform * vec4(a_Position,1.0);
+	gl_Position = u_ViewProjection * u_Transform * vec4(a_Position.xy, a_Position.z + u_Depth, 1.0);
 }
 
 
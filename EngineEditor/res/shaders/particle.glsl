@@ -0,0 +1,50 @@
+// Instanced Particle Shader
+
+#type vertex
+#version 330 core
+
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec2 a_TexCoord;
+layout(location = 2) in vec3 i_PositionSize;
+layout(location = 3) in vec4 i_Color;
+
+uniform mat4 u_ViewProjection;
+uniform float u_Depth;
+
+out vec2 v_TexCoord;
+out vec2 v_LocalPos;
+out vec4 v_Color;
+
+void main()
+{
+	v_TexCoord = a_TexCoord;
+	v_LocalPos = a_Position.xy;
+	v_Color = i_Color;
+	gl_Position = u_ViewProjection * vec4(i_PositionSize.xy + a_Position.xy * i_PositionSize.z, u_Depth, 1.0);
+}
+
+#type fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec2 v_TexCoord;
+in vec2 v_LocalPos;
+in vec4 v_Color;
+
+uniform sampler2D u_Texture;
+uniform int u_Textured;
+
+void main()
+{
+	if (u_Textured != 0) {
+		color = texture(u_Texture, v_TexCoord) * v_Color;
+	}
+	else {
+		float falloff = 1.0 - smoothstep(0.3, 0.5, length(v_LocalPos));
+		if (falloff <= 0.0)
+			discard;
+		color = v_Color;
+		color.a *= falloff;
+	}
+}
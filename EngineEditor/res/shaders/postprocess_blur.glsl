@@ -0,0 +1,41 @@
+// Separable 9 tap gaussian, five bilinear taps along u_Direction
+
+#type vertex
+#version 330 core
+
+layout(location = 0) in vec2 a_Position;
+
+out vec2 v_TexCoord;
+
+void main()
+{
+	v_TexCoord = a_Position * 0.5 + 0.5;
+	gl_Position = vec4(a_Position, 0.0, 1.0);
+}
+
+#type fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec2 v_TexCoord;
+
+uniform sampler2D u_Source;
+uniform vec2 u_UVScale;
+uniform vec2 u_TexelSize;
+// One texel along the blur axis
+uniform vec2 u_Direction;
+
+vec3 Sample(vec2 uv)
+{
+	return texture(u_Source, clamp(uv, vec2(0.0), u_UVScale - u_TexelSize * 0.5)).rgb;
+}
+
+void main()
+{
+	vec2 uv = v_TexCoord * u_UVScale;
+	vec3 sum = Sample(uv) * 0.2270270270;
+	sum += (Sample(uv + u_Direction * 1.3846153846) + Sample(uv - u_Direction * 1.3846153846)) * 0.3162162162;
+	sum += (Sample(uv + u_Direction * 3.2307692308) + Sample(uv - u_Direction * 3.2307692308)) * 0.0702702703;
+	color = vec4(sum, 1.0);
+}
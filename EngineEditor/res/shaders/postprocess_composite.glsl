@@ -0,0 +1,113 @@
+// Final post processing composite, every effect is skipped when its toggle is off
+// Also upscales a dynamic resolution scene to the output size
+
+#type vertex
+#version 330 core
+
+layout(location = 0) in vec2 a_Position;
+
+out vec2 v_TexCoord;
+
+void main()
+{
+	v_TexCoord = a_Position * 0.5 + 0.5;
+	gl_Position = vec4(a_Position, 0.0, 1.0);
+}
+
+#type fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec2 v_TexCoord;
+
+uniform sampler2D u_Source;
+uniform vec2 u_UVScale;
+// Set above 0 when a dynamic resolution source is upscaled
+uniform float u_Sharpness;
+uniform vec2 u_SourceTexelSize;
+
+uniform int u_Bloom;
+uniform sampler2D u_BloomTexture;
+uniform vec2 u_BloomUVScale;
+uniform float u_BloomIntensity;
+
+// Strip of u_LutSize cells, red across a cell, green down it and blue across the cells
+uniform int u_ColorGrading;
+uniform sampler2D u_Lut;
+uniform float u_LutSize;
+uniform float u_LutContribution;
+
+uniform int u_Vignette;
+uniform float u_VignetteIntensity;
+uniform float u_VignetteSmoothness;
+
+uniform int u_CRT;
+uniform float u_CRTCurvature;
+uniform float u_ScanlineIntensity;
+uniform float u_ScanlineCount;
+
+// Unsharp mask against the four source neighbours, restores the edges the bilinear upscale softened
+vec3 SampleSharpened(vec2 uv)
+{
+	vec3 center = texture(u_Source, uv).rgb;
+	if (u_Sharpness <= 0.0)
+		return center;
+
+	vec3 neighbours = texture(u_Source, uv + vec2(u_SourceTexelSize.x, 0.0)).rgb;
+	neighbours += texture(u_Source, uv - vec2(u_SourceTexelSize.x, 0.0)).rgb;
+	neighbours += texture(u_Source, uv + vec2(0.0, u_SourceTexelSize.y)).rgb;
+	neighbours += texture(u_Source, uv - vec2(0.0, u_SourceTexelSize.y)).rgb;
+	return clamp(center + (center - neighbours * 0.25) * u_Sharpness, 0.0, 1.0);
+}
+
+vec3 ApplyLut(vec3 value)
+{
+	float size = u_LutSize;
+	float blue = value.b * (size - 1.0);
+	float cell = floor(blue);
+	float nextCell = min(cell + 1.0, size - 1.0);
+
+	// Images are flipped on load, so rows further down the strip have smaller v
+	vec2 texel = vec2(value.r, value.g) * (size - 1.0) + 0.5;
+	float v = 1.0 - texel.y / size;
+	vec3 low = texture(u_Lut, vec2((cell * size + texel.x) / (size * size), v)).rgb;
+	vec3 high = texture(u_Lut, vec2((nextCell * size + texel.x) / (size * size), v)).rgb;
+	return mix(low, high, blue - cell);
+}
+
+void main()
+{
+	vec2 uv = v_TexCoord;
+	if (u_CRT != 0)
+	{
+		// Barrel distortion, the area curved out of the screen stays black
+		vec2 centered = uv * 2.0 - 1.0;
+		centered *= 1.0 + u_CRTCurvature * dot(centered, centered) * 0.25;
+		uv = centered * 0.5 + 0.5;
+		if (uv.x < 0.0 || uv.y < 0.0 || uv.x > 1.0 || uv.y > 1.0)
+		{
+			color = vec4(0.0, 0.0, 0.0, 1.0);
+			return;
+		}
+	}
+
+	vec3 result = SampleSharpened(uv * u_UVScale);
+	if (u_Bloom != 0)
+		result += texture(u_BloomTexture, uv * u_BloomUVScale).rgb * u_BloomIntensity;
+	result = clamp(result, 0.0, 1.0);
+
+	if (u_ColorGrading != 0)
+		result = mix(result, ApplyLut(result), u_LutContribution);
+
+	if (u_Vignette != 0)
+	{
+		float distance = length((uv - 0.5) * 2.0);
+		result *= 1.0 - u_VignetteIntensity * smoothstep(1.0 - u_VignetteSmoothness, 1.415, distance);
+	}
+
+	if (u_CRT != 0)
+		result *= 1.0 - u_ScanlineIntensity * (0.5 + 0.5 * cos(uv.y * u_ScanlineCount * 3.14159265));
+
+	color = vec4(result, 1.0);
+}
@@ -0,0 +1,47 @@
+// Bloom prefilter, keeps the part of every texel above the threshold while downsampling
+
+#type vertex
+#version 330 core
+
+layout(location = 0) in vec2 a_Position;
+
+out vec2 v_TexCoord;
+
+void main()
+{
+	v_TexCoord = a_Position * 0.5 + 0.5;
+	gl_Position = vec4(a_Position, 0.0, 1.0);
+}
+
+#type fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec2 v_TexCoord;
+
+uniform sampler2D u_Source;
+uniform vec2 u_UVScale;
+uniform vec2 u_TexelSize;
+uniform float u_Threshold;
+
+vec3 Sample(vec2 uv)
+{
+	// Stay inside the used part of an over-allocated source
+	return texture(u_Source, clamp(uv, vec2(0.0), u_UVScale - u_TexelSize * 0.5)).rgb;
+}
+
+void main()
+{
+	// Four bilinear taps average a 4x4 block, enough to downsample by up to a quarter without aliasing
+	vec2 uv = v_TexCoord * u_UVScale;
+	vec3 sum = Sample(uv + u_TexelSize * vec2(-1.0, -1.0));
+	sum += Sample(uv + u_TexelSize * vec2(1.0, -1.0));
+	sum += Sample(uv + u_TexelSize * vec2(-1.0, 1.0));
+	sum += Sample(uv + u_TexelSize * vec2(1.0, 1.0));
+	sum *= 0.25;
+
+	float brightness = max(sum.r, max(sum.g, sum.b));
+	float contribution = max(brightness - u_Threshold, 0.0) / max(brightness, 0.0001);
+	color = vec4(sum * contribution, 1.0);
+}
@@ -10,14 +10,36 @@ uniform mat4 u_ViewProjection;
 uniform mat4 u_Transform;
 uniform vec2 u_Scale;
 uniform vec2 u_Offset;
+uniform float u_Depth;
+
+// Sprite sheet animation: x = start time, y = fps (0 when stopped), z = first frame, w = loop
+uniform float u_Time;
+uniform vec4 u_Animation;
+uniform float u_FrameCount;
 
 out vec2 v_TexCoord;
+// World position and the sprite's axes in world space, for lighting
+out vec2 v_WorldPos;
+out vec2 v_TangentX;
+out vec2 v_TangentY;
 
 void main()
 {
-	v_TexCoord.x = (a_TexCoord.x - 0.5) * u_Scale.x + (0.5 * u_Scale.x) - u_Offset.x;
+	float frames = max(u_FrameCount, 1.0);
+	float frame = u_Animation.z + floor(max(u_Time - u_Animation.x, 0.0) * u_Animation.y);
+	if (u_Animation.w > 0.5)
+		frame = mod(frame, frames);
+	else if (frame >= frames)
+		frame = 0.0;
+
+	float texX = (a_TexCoord.x + frame) / frames;
+	v_TexCoord.x = (texX - 0.5) * u_Scale.x + (0.5 * u_Scale.x) - u_Offset.x;
 	v_TexCoord.y = (a_TexCoord.y - 0.5) * u_Scale.y + (0.5 * u_Scale.y) - u_Offset.y;
-	gl_Position = u_ViewProjection * u_Transform * vec4(a_Position, 1.0);
+	vec4 worldPos = u_Transform * vec4(a_Position.xy, a_Position.z + u_Depth, 1.0);
+	v_WorldPos = worldPos.xy;
+	v_TangentX = normalize(u_Transform[0].xy);
+	v_TangentY = normalize(u_Transform[1].xy);
+	gl_Position = u_ViewProjection * worldPos;
 }
 
 #type fragment
@@ -26,11 +48,79 @@ void main()
 layout(location = 0) out vec4 color;
 
 in vec2 v_TexCoord;
+in vec2 v_WorldPos;
+in vec2 v_TangentX;
+in vec2 v_TangentY;
 
 uniform vec4 u_Color;
 uniform sampler2D u_Texture;
+uniform float u_AlphaCutoff;
+
+// Tiled lighting, see Renderer2D::EndLighting
+// u_LightData holds 3 texels per light row: (position, radius, height), (color, spot), (direction, cos inner, cos outer)
+// u_LightTiles holds (first index, count) per screen tile, u_LightIndices four light indices per texel
+uniform int u_Lit;
+uniform vec3 u_Ambient;
+uniform float u_LightTileSize;
+uniform sampler2D u_LightData;
+uniform sampler2D u_LightTiles;
+uniform sampler2D u_LightIndices;
+uniform int u_HasNormalMap;
+uniform sampler2D u_NormalMap;
+
+vec3 GetNormal()
+{
+	if (u_HasNormalMap == 0)
+		return vec3(0.0, 0.0, 1.0);
+
+	// Images are flipped on load, so the map's up is the sprite's -y
+	vec3 n = texture(u_NormalMap, v_TexCoord).xyz * 2.0 - 1.0;
+	return normalize(vec3(n.x * v_TangentX - n.y * v_TangentY, n.z));
+}
+
+vec3 GetLighting()
+{
+	vec3 normal = GetNormal();
+	vec3 light = u_Ambient;
+
+	vec2 tile = texelFetch(u_LightTiles, ivec2(gl_FragCoord.xy / u_LightTileSize), 0).xy;
+	int first = int(tile.x);
+	int count = int(tile.y);
+	int width = textureSize(u_LightIndices, 0).x;
+	for (int i = 0; i < count; i++)
+	{
+		int entry = first + i;
+		int texel = entry / 4;
+		int index = int(texelFetch(u_LightIndices, ivec2(texel % width, texel / width), 0)[entry % 4]);
+
+		vec4 shape = texelFetch(u_LightData, ivec2(0, index), 0);
+		vec4 colorSpot = texelFetch(u_LightData, ivec2(1, index), 0);
+		vec2 delta = shape.xy - v_WorldPos;
+		float distanceSq = dot(delta, delta);
+		float radiusSq = shape.z * shape.z;
+		if (distanceSq >= radiusSq)
+			continue;
+
+		float falloff = 1.0 - distanceSq / radiusSq;
+		falloff *= falloff;
+		if (colorSpot.w > 0.5)
+		{
+			vec4 cone = texelFetch(u_LightData, ivec2(2, index), 0);
+			float cosAngle = distanceSq > 0.0 ? dot(-delta * inversesqrt(distanceSq), cone.xy) : 1.0;
+			falloff *= smoothstep(cone.w, max(cone.z, cone.w + 0.0001), cosAngle);
+		}
+
+		float diffuse = max(dot(normal, normalize(vec3(delta, shape.w))), 0.0);
+		light += colorSpot.rgb * falloff * diffuse;
+	}
+	return light;
+}
 
 void main()
 {
 	color = texture(u_Texture, v_TexCoord) * u_Color;
+	if (color.a < u_AlphaCutoff)
+		discard;
+	if (u_Lit != 0)
+		color.rgb *= GetLighting();
 }
\ No newline at end of file
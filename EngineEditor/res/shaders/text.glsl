@@ -0,0 +1,41 @@
+// Batched SDF Text Shader
+
+#type vertex
+#version 330 core
+
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec2 a_TexCoord;
+layout(location = 2) in vec4 a_Color;
+
+uniform mat4 u_ViewProjection;
+
+out vec2 v_TexCoord;
+out vec4 v_Color;
+
+void main()
+{
+	v_TexCoord = a_TexCoord;
+	v_Color = a_Color;
+	gl_Position = u_ViewProjection * vec4(a_Position, 1.0);
+}
+
+#type fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec2 v_TexCoord;
+in vec4 v_Color;
+
+uniform sampler2D u_Texture;
+
+void main()
+{
+	// The atlas alpha is a signed distance with the glyph edge at 0.5
+	float distance = texture(u_Texture, v_TexCoord).a;
+	float width = max(fwidth(distance) * 0.75, 0.001);
+	float alpha = smoothstep(0.5 - width, 0.5 + width, distance);
+	if (alpha <= 0.0)
+		discard;
+	color = vec4(v_Color.rgb, v_Color.a * alpha);
+}
@@ -44,6 +44,8 @@ public:
 		ProjectManager::CompileRootLib();
 		
 		m_runtime.settings.DrawGrid = true;
+		//The viewport only redraws on changes, so with nothing happening the loop can wait for input
+		FramePacer::GetSettings().IdleWait = true;
 	}
 
 	void OnImGuiRender() override {
@@ -56,6 +58,7 @@ public:
 		m_panel_assetbrowser->OnImGuiRender();
 		m_panel_viewport->OnImGuiRender();
 		m_runtime.settings.UpdateCamera = m_panel_viewport->GetSelected();
+		MarkSceneDirtyOnEdit();
 	}
 
 private:
@@ -70,6 +73,16 @@ private:
 
 private:
 
+	//Panels write components and render settings directly, so any widget edit, click or drop redraws the viewport
+	void MarkSceneDirtyOnEdit() {
+		if (!ProjectManager::IsActiveScene())
+			return;
+		bool edited = ImGui::GetCurrentContext()->ActiveIdHasBeenEditedThisFrame;
+		bool clicked = ImGui::IsMouseReleased(ImGuiMouseButton_Left) || ImGui::IsMouseReleased(ImGuiMouseButton_Right);
+		if (edited || clicked || ImGui::IsAnyItemActive() || ImGui::GetDragDropPayload())
+			ProjectManager::GetActiveScene()->MarkDirty();
+	}
+
 	void DrawDockSpace() {
 		static ImGuiDockNodeFlags dockspace_flags = ImGuiDockNodeFlags_PassthruCentralNode;
 		ImGuiWindowFlags window_flags = ImGuiWindowFlags_MenuBar | ImGuiWindowFlags_NoDocking;
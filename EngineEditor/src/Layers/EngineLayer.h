@@ -55,6 +55,8 @@ public:
 		if (ProjectManager::IsActiveScene()) {
 			auto& scene = ProjectManager::GetActiveScene();
 			if (scene->IsPlaying()) {
+				//The game changes every frame, idle waits would freeze it between inputs
+				FramePacer::RequestFrame();
 				scene->OnUpdateRuntime(timestep);
 			}
 			else {
@@ -38,7 +38,7 @@ namespace SurfEngine {
 				for (auto entity : group) {
 					auto [tag, transform] = group.get<TagComponent, TransformComponent>(entity);
 					if (ProjectManager::GetActiveScene()->m_Registry.valid(entity)) {
-						if(transform.parent == nullptr)
+						if(transform.Parent == entt::null)
 							DrawObjectNode(Object(entity, ProjectManager::GetActiveScene().get()));
 					}
 				}
@@ -84,7 +84,7 @@ namespace SurfEngine {
 		}
 
 		
-		ImGuiTreeNodeFlags flags = ((selectHighlight) ? ImGuiTreeNodeFlags_Selected : 0) | ((tc.children.size() > 0) ? ImGuiTreeNodeFlags_OpenOnArrow : ImGuiTreeNodeFlags_Leaf) | ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_DefaultOpen;
+		ImGuiTreeNodeFlags flags = ((selectHighlight) ? ImGuiTreeNodeFlags_Selected : 0) | ((tc.HasChildren()) ? ImGuiTreeNodeFlags_OpenOnArrow : ImGuiTreeNodeFlags_Leaf) | ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_DefaultOpen;
 
 		
 		if (ImGui::TreeNodeEx((void*)(uint64_t)(uint32_t)object, flags, tag.Tag.c_str()))
@@ -133,12 +133,15 @@ namespace SurfEngine {
 				if (ImGui::MenuItem("Delete")) {
 					ProjectManager::GetActiveScene()->DeleteObject(object);
 					ProjectManager::ClearSelectedObject();
+					entityDeleted = true;
 				}
 				
 				ImGui::EndPopup();
 			}
-			for (int i = 0; i < tc.children.size(); i++) {
-				DrawObjectNode(tc.children[i]->gameObject);
+			//Duplicating can move tc in storage, a deleted object took its children with it
+			if (!entityDeleted) {
+				TransformComponent& transform = ProjectManager::GetActiveScene()->m_Registry.get<TransformComponent>(object);
+				transform.ForEachChild([&](TransformComponent& child) { DrawObjectNode(child.gameObject); });
 			}
 
 			ImGui::TreePop();
@@ -55,6 +55,10 @@ namespace SurfEngine {
 					if (o->HasComponent<TagComponent>()) { DrawComponentTag(o); }
 					if (o->HasComponent<TransformComponent>()) { DrawComponentTransform(o); }
 					if (o->HasComponent<SpriteRendererComponent>()) { DrawComponentSpriteRenderer(o); }
+					if (o->HasComponent<TilemapComponent>()) { DrawComponentTilemap(o); }
+					if (o->HasComponent<ParticleEmitterComponent>()) { DrawComponentParticleEmitter(o); }
+					if (o->HasComponent<TextComponent>()) { DrawComponentText(o); }
+					if (o->HasComponent<LightComponent>()) { DrawComponentLight(o); }
 					if (o->HasComponent<AnimationComponent>()) { DrawComponentAnimation(o); }
 					if (o->HasComponent<CameraComponent>()) { DrawComponentCamera(o); }
 					if (o->HasComponent<RigidbodyComponent>()) { DrawComponentRigidBody(o); }
@@ -113,6 +117,18 @@ namespace SurfEngine {
 				if (ImGui::MenuItem("Sprite Renderer")) {
 					if (!o->HasComponent<SpriteRendererComponent>()) { o->AddComponent<SpriteRendererComponent>(); }
 				}
+				if (ImGui::MenuItem("Tilemap")) {
+					if (!o->HasComponent<TilemapComponent>()) { o->AddComponent<TilemapComponent>(); }
+				}
+				if (ImGui::MenuItem("Particle Emitter")) {
+					if (!o->HasComponent<ParticleEmitterComponent>()) { o->AddComponent<ParticleEmitterComponent>(); }
+				}
+				if (ImGui::MenuItem("Text")) {
+					if (!o->HasComponent<TextComponent>()) { o->AddComponent<TextComponent>(); }
+				}
+				if (ImGui::MenuItem("Light")) {
+					if (!o->HasComponent<LightComponent>()) { o->AddComponent<LightComponent>(); }
+				}
 				if (ImGui::MenuItem("Animation")) {
 					if (!o->HasComponent<AnimationComponent>()) { o->AddComponent<AnimationComponent>(); }
 				}
@@ -148,7 +164,7 @@ namespace SurfEngine {
 			size_t nameBufferSize = tc.Tag.size() + 16;
 			ImGui::PushID("NameTextField");
 			if (ImGui::InputText("", nameBuffer, nameBufferSize, ImGuiInputTextFlags_EnterReturnsTrue)) {
-				if (std::strcmp(nameBuffer, "") != 0) { tc.Tag = nameBuffer; }
+				if (std::strcmp(nameBuffer, "") != 0) { o->GetScene()->RenameObject(*o, nameBuffer); }
 			}
 			ImGui::PopID();
 			delete[] nameBuffer;
@@ -178,20 +194,19 @@ namespace SurfEngine {
 		float scale[3] = { tc.Scale.x, tc.Scale.y, tc.Scale.z };
 
 		ImGui::Text("Position");
-		ImGui::DragFloat2("##pos", pos, 0.25f);
+		bool changed = ImGui::DragFloat2("##pos", pos, 0.25f);
 
 		ImGui::Text("Rotation");
-		ImGui::DragFloat("##rot", rot, 0.25f);
+		changed |= ImGui::DragFloat("##rot", rot, 0.25f);
 
 		ImGui::Text("Scale");
 
-		ImGui::DragFloat3("##scale",scale,0.25f);
-		tc.Translation.x = pos[0];
-		tc.Translation.y = -pos[1];
-		tc.Scale.x = scale[0];
-		tc.Scale.y = scale[1];
-		tc.Scale.z = scale[2];
-		tc.Rotation.z = rot[0];
+		changed |= ImGui::DragFloat3("##scale",scale,0.25f);
+		if (changed) {
+			tc.SetTranslation({ pos[0], -pos[1], tc.Translation.z });
+			tc.SetRotation({ tc.Rotation.x, tc.Rotation.y, rot[0] });
+			tc.SetScale({ scale[0], scale[1], scale[2] });
+		}
 		ImGui::Separator();
 	}
 
@@ -203,15 +218,21 @@ namespace SurfEngine {
 		
 
 		SpriteRendererComponent& sr = o->GetComponent<SpriteRendererComponent>();
+		//Only the edited sprite's render data is rebuilt
+		bool changed = false;
 		ImGui::NewLine();
 		float color[4] = { sr.Color.r,sr.Color.g, sr.Color.b, sr.Color.a };
 		ImGui::Text("Base Color");
-		ImGui::ColorEdit4("", color);
+		changed |= ImGui::ColorEdit4("", color);
 		sr.Color = { color[0],color[1], color[2], color[3] };
 		ImGui::NewLine();
 		int layer_value = sr.Layer;
-		ImGui::InputInt("Layer",&layer_value,1,5);
+		changed |= ImGui::InputInt("Layer",&layer_value,1,5);
 		sr.Layer = layer_value < 0 ? sr.Layer : layer_value;
+		bool static_layer = o->GetScene()->IsLayerStatic(sr.Layer);
+		if (ImGui::Checkbox("Static Layer", &static_layer)) {
+			o->GetScene()->SetLayerStatic(sr.Layer, static_layer);
+		}
 		ImGui::NewLine();
 		ImGui::Text("Sprite");
 
@@ -227,6 +248,7 @@ namespace SurfEngine {
 					memcpy((char*)&path[0], payload->Data, payload->DataSize);
 					sr.Texture_Path = path;
 					sr.Texture = Texture2D::Create(sr.Texture_Path);
+					changed = true;
 					SE_CORE_WARN("Changed Sprite to: " + sr.Texture_Path);
 				}
 				ImGui::EndDragDropTarget();
@@ -240,17 +262,35 @@ namespace SurfEngine {
 			if (!img_path.empty()) {
 				sr.Texture_Path = img_path;
 				sr.Texture = Texture2D::Create(img_path);
+				changed = true;
 				SE_CORE_WARN("Changed Sprite to: " + img_path);
 			}
 		}
-		ImGui::Checkbox("Flip X", &sr.flipX);
+		ImGui::Text("Normal Map: %s", sr.NormalMap_Path.empty() ? "None" : sr.NormalMap_Path.c_str());
+		if (ImGui::Button("Select Normal Map")) {
+			std::string img_path = FileDialogs::OpenFile(ProjectManager::GetPath(), "Image (*.png)\0*.png\0");
+			if (!img_path.empty()) {
+				sr.NormalMap_Path = img_path;
+				sr.NormalMap = Texture2D::Create(img_path);
+				changed = true;
+			}
+		}
+		if (sr.NormalMap) {
+			ImGui::SameLine();
+			if (ImGui::Button("Clear Normal Map")) {
+				sr.NormalMap_Path = "";
+				sr.NormalMap = nullptr;
+				changed = true;
+			}
+		}
+		changed |= ImGui::Checkbox("Flip X", &sr.flipX);
 		ImGui::Checkbox("Reflective", &sr.reflective);
 
 		float scaling[2] = { sr.scaling.x,sr.scaling.y };
 		float offset [2] = { sr.offset.x, sr.offset.y };
 
 		ImGui::Text("Scaling");
-		ImGui::DragFloat2("##sr_scaling", scaling, 0.25f);
+		changed |= ImGui::DragFloat2("##sr_scaling", scaling, 0.25f);
 
 		ImGui::SameLine();
 
@@ -258,17 +298,29 @@ namespace SurfEngine {
 			auto& tc = o->GetComponent<TransformComponent>();
 			scaling[0] = tc.Scale.x;
 			scaling[1] = tc.Scale.y;
+			changed = true;
 		}
 
 		ImGui::Text("Offset");
-		ImGui::DragFloat2("##sr_offset", offset, 0.25f);
+		changed |= ImGui::DragFloat2("##sr_offset", offset, 0.25f);
 
 		sr.scaling.x = scaling[0];
 		sr.scaling.y = scaling[1];
 		sr.offset.x  = offset[0];
 		sr.offset.y  = offset[1];
 
+		int meshVertices = (int)sr.MeshVertexBudget;
+		ImGui::Text("Mesh Vertices"); ImGui::SameLine();
+		if (ImGui::InputInt("##sr_mesh_vertices", &meshVertices)) {
+			sr.MeshVertexBudget = (unsigned int)std::clamp(meshVertices, 0, 32);
+			changed = true;
+		}
+		if (ImGui::IsItemHovered())
+			ImGui::SetTooltip("Draws an outline around the visible texels instead of the quad, 0 always draws the quad");
+
 		if (!sr.Texture) { sr.reflective = false; }
+		if (changed)
+			o->GetScene()->UpdateSpriteRenderData(*o);
 		ImGui::Separator();
 
 		if (ImGui::BeginPopup("RemoveComp")) {
@@ -281,6 +333,210 @@ namespace SurfEngine {
 
 	}
 
+	void Panel_Inspector::DrawComponentTilemap(Ref<Object> o) {
+		ImGui::PushID("Tilemap");
+		ImGui::Text("Tilemap");
+		ImGui::OpenPopupOnItemClick("RemoveComp");
+
+		TilemapComponent& tmc = o->GetComponent<TilemapComponent>();
+		ImGui::NewLine();
+		float color[4] = { tmc.Color.r,tmc.Color.g, tmc.Color.b, tmc.Color.a };
+		ImGui::Text("Base Color");
+		ImGui::ColorEdit4("", color);
+		tmc.Color = { color[0],color[1], color[2], color[3] };
+		ImGui::NewLine();
+		int layer_value = tmc.Layer;
+		ImGui::InputInt("Layer", &layer_value, 1, 5);
+		if (layer_value >= 0 && (unsigned int)layer_value != tmc.Layer) {
+			tmc.Layer = layer_value;
+			tmc.Invalidate();
+		}
+		ImGui::NewLine();
+
+		ImGui::Text("Tileset");
+		if (tmc.Tileset) {
+			ImGui::Image((ImTextureID)(uint64_t)tmc.Tileset->GetRendererID(), ImVec2{ 128,128 }, ImVec2(0, 1), ImVec2(1, 0), ImVec4(1, 1, 1, 1), ImVec4(0, 0, 0, 1));
+			ImGui::SameLine();
+		}
+		if (ImGui::Button("Select Tileset")) {
+			std::string img_path = FileDialogs::OpenFile(ProjectManager::GetPath(), "Image (*.png)\0*.png\0");
+			if (!img_path.empty()) {
+				tmc.Tileset_Path = img_path;
+				tmc.Tileset = Texture2D::Create(img_path);
+				tmc.Invalidate();
+			}
+		}
+
+		int grid[2] = { tmc.Columns, tmc.Rows };
+		if (ImGui::InputInt2("Columns / Rows", grid)) {
+			tmc.Columns = std::max(grid[0], 1);
+			tmc.Rows = std::max(grid[1], 1);
+			tmc.Invalidate();
+		}
+		ImGui::Text("Chunks: %d", (int)tmc.Chunks.size());
+		ImGui::NewLine();
+
+		ImGui::Text("Paint");
+		ImGui::InputInt("Tile", &m_TileBrush);
+		m_TileBrush = std::max(m_TileBrush, 0);
+		ImGui::InputInt4("X / Y / W / H", m_TileRegion);
+		bool fill = ImGui::Button("Fill");
+		ImGui::SameLine();
+		bool erase = ImGui::Button("Erase");
+		if (fill || erase) {
+			for (int y = m_TileRegion[1]; y < m_TileRegion[1] + m_TileRegion[3]; y++)
+				for (int x = m_TileRegion[0]; x < m_TileRegion[0] + m_TileRegion[2]; x++)
+					tmc.SetTile(x, y, erase ? -1 : m_TileBrush);
+		}
+		ImGui::Separator();
+
+		if (ImGui::BeginPopup("RemoveComp")) {
+			if (ImGui::Selectable("Remove")) {
+				o->RemoveComponent<TilemapComponent>();
+			}
+			ImGui::EndPopup();
+		}
+		ImGui::PopID();
+	}
+
+	void Panel_Inspector::DrawComponentParticleEmitter(Ref<Object> o) {
+		ImGui::PushID("ParticleEmitter");
+		ImGui::Text("Particle Emitter");
+		ImGui::OpenPopupOnItemClick("RemoveComp");
+
+		ParticleEmitterComponent& pec = o->GetComponent<ParticleEmitterComponent>();
+		ImGui::NewLine();
+
+		int max_particles = (int)pec.MaxParticles;
+		ImGui::InputInt("Max Particles", &max_particles, 100, 1000);
+		pec.MaxParticles = (uint32_t)std::max(max_particles, 1);
+		ImGui::DragFloat("Emission Rate", &pec.EmissionRate, 1.0f, 0.0f, 100000.0f);
+		ImGui::DragFloat("Lifetime", &pec.Lifetime, 0.05f, 0.01f, 100.0f);
+		ImGui::DragFloat("Lifetime Variation", &pec.LifetimeVariation, 0.01f, 0.0f, 1.0f);
+		ImGui::DragFloat2("Velocity", &pec.Velocity.x, 0.1f);
+		ImGui::DragFloat2("Velocity Variation", &pec.VelocityVariation.x, 0.1f, 0.0f, 1000.0f);
+		ImGui::DragFloat2("Gravity", &pec.Gravity.x, 0.1f);
+		ImGui::DragFloat("Drag", &pec.Drag, 0.01f, 0.0f, 100.0f);
+		ImGui::ColorEdit4("Color Begin", &pec.ColorBegin.x);
+		ImGui::ColorEdit4("Color End", &pec.ColorEnd.x);
+		ImGui::DragFloat("Size Begin", &pec.SizeBegin, 0.01f, 0.0f, 100.0f);
+		ImGui::DragFloat("Size End", &pec.SizeEnd, 0.01f, 0.0f, 100.0f);
+
+		int layer_value = pec.Layer;
+		ImGui::InputInt("Layer", &layer_value, 1, 5);
+		pec.Layer = layer_value < 0 ? pec.Layer : layer_value;
+
+		if (ImGui::Button("Select Texture")) {
+			std::string img_path = FileDialogs::OpenFile(ProjectManager::GetPath(), "Image (*.png)\0*.png\0");
+			if (!img_path.empty()) {
+				pec.Texture_Path = img_path;
+				pec.Texture = Texture2D::Create(img_path);
+			}
+		}
+		if (pec.Texture) {
+			ImGui::SameLine();
+			if (ImGui::Button("Clear Texture")) {
+				pec.Texture_Path = "";
+				pec.Texture = nullptr;
+			}
+		}
+		if (pec.Pool)
+			ImGui::Text("Particles: %u", pec.Pool->GetCount());
+		ImGui::Separator();
+
+		if (ImGui::BeginPopup("RemoveComp")) {
+			if (ImGui::Selectable("Remove")) {
+				o->RemoveComponent<ParticleEmitterComponent>();
+			}
+			ImGui::EndPopup();
+		}
+		ImGui::PopID();
+	}
+
+	void Panel_Inspector::DrawComponentText(Ref<Object> o) {
+		ImGui::PushID("Text");
+		ImGui::Text("Text");
+		ImGui::OpenPopupOnItemClick("RemoveComp");
+
+		TextComponent& tc = o->GetComponent<TextComponent>();
+		ImGui::NewLine();
+
+		char buffer[1024];
+		memset(buffer, 0, sizeof(buffer));
+		strncpy(buffer, tc.Text.c_str(), sizeof(buffer) - 1);
+		if (ImGui::InputTextMultiline("##TextValue", buffer, sizeof(buffer)))
+			tc.Text = std::string(buffer);
+
+		ImGui::ColorEdit4("Color", &tc.Color.x);
+		ImGui::DragFloat("Kerning", &tc.Kerning, 0.005f, -1.0f, 1.0f);
+		ImGui::DragFloat("Line Spacing", &tc.LineSpacing, 0.01f, 0.0f, 10.0f);
+
+		int layer_value = tc.Layer;
+		ImGui::InputInt("Layer", &layer_value, 1, 5);
+		tc.Layer = layer_value < 0 ? tc.Layer : layer_value;
+
+		ImGui::Text("Font: %s", tc.Font_Path.empty() ? "Default" : tc.Font_Path.c_str());
+		if (ImGui::Button("Select Font")) {
+			std::string font_path = FileDialogs::OpenFile(ProjectManager::GetPath(), "Font (*.ttf)\0*.ttf\0");
+			if (!font_path.empty()) {
+				tc.Font_Path = font_path;
+				tc.FontAsset = Renderer2D::GetFont(font_path);
+			}
+		}
+		if (tc.FontAsset) {
+			ImGui::SameLine();
+			if (ImGui::Button("Clear Font")) {
+				tc.Font_Path = "";
+				tc.FontAsset = nullptr;
+			}
+		}
+		ImGui::Separator();
+
+		if (ImGui::BeginPopup("RemoveComp")) {
+			if (ImGui::Selectable("Remove")) {
+				o->RemoveComponent<TextComponent>();
+			}
+			ImGui::EndPopup();
+		}
+		ImGui::PopID();
+	}
+
+	void Panel_Inspector::DrawComponentLight(Ref<Object> o) {
+		ImGui::PushID("Light");
+		ImGui::Text("Light");
+		ImGui::OpenPopupOnItemClick("RemoveComp");
+
+		LightComponent& lc = o->GetComponent<LightComponent>();
+		ImGui::NewLine();
+
+		const char* types[] = { "Point", "Spot", "Global" };
+		int type = (int)lc.LightType;
+		if (ImGui::Combo("Type", &type, types, IM_ARRAYSIZE(types)))
+			lc.LightType = (LightComponent::Type)type;
+
+		ImGui::ColorEdit3("Color", &lc.Color.x);
+		ImGui::DragFloat("Intensity", &lc.Intensity, 0.05f, 0.0f, 100.0f);
+		if (lc.LightType != LightComponent::Type::Global) {
+			ImGui::DragFloat("Radius", &lc.Radius, 0.1f, 0.0f, 1000.0f);
+			ImGui::DragFloat("Height", &lc.Height, 0.05f, 0.0f, 100.0f);
+			if (ImGui::IsItemHovered())
+				ImGui::SetTooltip("Distance above the sprites, only matters for normal mapped sprites");
+		}
+		if (lc.LightType == LightComponent::Type::Spot) {
+			ImGui::DragFloat("Inner Angle", &lc.InnerAngle, 0.5f, 0.0f, lc.OuterAngle);
+			ImGui::DragFloat("Outer Angle", &lc.OuterAngle, 0.5f, 0.0f, 360.0f);
+		}
+		ImGui::Separator();
+
+		if (ImGui::BeginPopup("RemoveComp")) {
+			if (ImGui::Selectable("Remove")) {
+				o->RemoveComponent<LightComponent>();
+			}
+			ImGui::EndPopup();
+		}
+		ImGui::PopID();
+	}
+
 	void Panel_Inspector::DrawComponentCamera(Ref<Object> o) {
 
 		ImGui::PushID("Camera");
@@ -20,10 +20,16 @@ namespace SurfEngine {
 	private:
 		Ref<Panel_Hierarchy> m_panel_hierarchy;
 		bool m_DebugMode = false;
+		int m_TileBrush = 0;
+		int m_TileRegion[4] = { 0, 0, 1, 1 };
 	private:
 		void DrawComponentTag(Ref<Object>);
 		void DrawComponentTransform(Ref<Object>);
 		void DrawComponentSpriteRenderer(Ref<Object>);
+		void DrawComponentTilemap(Ref<Object>);
+		void DrawComponentParticleEmitter(Ref<Object>);
+		void DrawComponentText(Ref<Object>);
+		void DrawComponentLight(Ref<Object>);
 		void DrawComponentAnimation(Ref<Object>);
 		void DrawComponentCamera(Ref<Object>);
 		void DrawComponentScript(Ref<Object>);
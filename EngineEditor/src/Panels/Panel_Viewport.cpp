@@ -78,13 +78,20 @@ namespace SurfEngine {
 			if (ImGui::ImageButton((ImTextureID)(uint64_t)m_PlayButton_CurrIcon->GetRendererID(), ImVec2((float)16, (float)16), ImVec2(0, 1), ImVec2(1, 0))) {
 				if (!scene->IsPlaying()) {
 					ProjectManager::CompileProjectScripts();
-					ProjectManager::SaveCurrentScene();
+					m_EditSnapshot.Capture(*scene);
 					scene->OnSceneStart();
 					m_PlayButton_CurrIcon = m_PlayButton_StopIcon;
 				}
 				else {
 					scene->OnSceneEnd();
-					ProjectManager::OpenLastScene();
+					if (!m_EditSnapshot.Restore(*scene))
+						ProjectManager::OpenLastScene();
+					m_EditSnapshot.Clear();
+
+					//Objects created while playing are gone again
+					Ref<Object> selected = ProjectManager::GetSelectedObject();
+					if (ProjectManager::IsSelectedObject() && !scene->GetRegistry()->valid(*selected))
+						ProjectManager::ClearSelectedObject();
 					m_PlayButton_CurrIcon = m_PlayButton_PlayIcon;
 				}
 			}
@@ -100,8 +107,9 @@ namespace SurfEngine {
 			ImGui::SetCursorPosX((windowSize.x - m_ImageSize.x) * 0.5f);
 			ImGui::SetCursorPosY(((windowSize.y - m_ImageSize.y) * 0.5f) + (ImGui::GetWindowHeight() - windowSize.y));
 			uint32_t textureID = Renderer2D::GetOutputAsTextureId();
+			glm::vec2 uvScale = Renderer2D::GetOutputUVScale();
 			ImGui::PushID("ViewportDragTargetZone");
-			ImGui::Image((void*)(uint64_t)textureID, { m_ImageSize.x, m_ImageSize.y });
+			ImGui::Image((void*)(uint64_t)textureID, { m_ImageSize.x, m_ImageSize.y }, { 0, 0 }, { uvScale.x, uvScale.y });
 			if (ImGui::BeginDragDropTarget())
 			{
 				char* path;
@@ -1,6 +1,7 @@
 #pragma once
 #include "SurfEngine/Core/Core.h"
 #include "SurfEngine/Scenes/Scene.h"
+#include "SurfEngine/Scenes/SceneSnapshot.h"
 #include "SurfEngine/Renderer/Texture.h"
 #include <imgui/imgui.h>
 #include <imgui/imgui_internal.h>
@@ -34,6 +35,8 @@ namespace SurfEngine {
 		ImVec2 m_ViewPortSize = ImVec2(0,0 );
 		ImVec2 m_ImageSize = ImVec2(0,0);
 		bool m_IsSelected = false;
+		// The edited scene as it was before play mode, put back when play stops
+		SceneSnapshot m_EditSnapshot;
 	};
 }
 
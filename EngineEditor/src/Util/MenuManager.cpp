@@ -1,6 +1,8 @@
 #include "MenuManager.h"
 #include "SurfEngine/Physics/PhysicsEngine.h"
 #include "SurfEngine/Scripting/ScriptEngine.h"
+#include "SurfEngine/Renderer/PostProcessing.h"
+#include "SurfEngine/Renderer/DynamicResolution.h"
 
 static char* input_buff;
 
@@ -29,6 +31,39 @@ void MenuManager::DrawNewProjectPopup() {
 
 void DrawGeneralOptions() {
 	ImGui::Text("General Options");
+
+	FramePacer::Settings& pacing = FramePacer::GetSettings();
+	ImGui::Text("Frame Pacing");
+	bool vsync = Application::Get().GetWindow().IsVSync();
+	if (ImGui::Checkbox("VSync", &vsync))
+		Application::Get().GetWindow().SetVSync(vsync);
+	ImGui::DragInt("Target FPS (0 = Unlimited)", &pacing.TargetFPS, 1.0f, 0, 500);
+	ImGui::DragInt("Background FPS", &pacing.BackgroundFPS, 1.0f, 0, 500);
+	ImGui::Checkbox("Idle When Nothing Changes", &pacing.IdleWait);
+	if (pacing.IdleWait)
+		ImGui::DragFloat("Idle Timeout (s)", &pacing.IdleTimeout, 0.01f, 0.01f, 5.0f);
+
+	const FramePacer::Statistics& stats = FramePacer::GetStats();
+	ImGui::Text("Frame Time: %.2f ms (%.2f - %.2f)", stats.AverageFrameTime, stats.MinFrameTime, stats.MaxFrameTime);
+	ImGui::Text("Jitter: %.2f ms", stats.Jitter);
+	ImGui::Text("Missed Frames: %u", stats.MissedFrames);
+
+	const JobSystem::Statistics& jobs = JobSystem::GetStats();
+	ImGui::Text("Job System");
+	ImGui::Text("Workers: %u, Utilization: %.0f%%", jobs.Workers, jobs.Utilization * 100.0f);
+	ImGui::Text("Jobs: %u (%u stolen)", jobs.JobsExecuted, jobs.JobsStolen);
+
+	if (Ref<Scene>& scene = ProjectManager::GetActiveScene()) {
+		const SystemScheduler& systems = scene->GetSystemScheduler();
+		ImGui::Text("Scene Systems: %.2f ms", systems.GetRunTime());
+		for (const SystemScheduler::Timing& timing : systems.GetTimings())
+			ImGui::Text("  %s: %.3f ms%s", timing.Name.c_str(), timing.Milliseconds, timing.MainThread ? " (main thread)" : "");
+
+		const SystemScheduler& fixedSystems = scene->GetFixedSystemScheduler();
+		ImGui::Text("Fixed Steps: %u, %.2f ms each", scene->GetFixedSteps(), fixedSystems.GetRunTime());
+		for (const SystemScheduler::Timing& timing : fixedSystems.GetTimings())
+			ImGui::Text("  %s: %.3f ms%s", timing.Name.c_str(), timing.Milliseconds, timing.MainThread ? " (main thread)" : "");
+	}
 }
 
 void DrawInputOptions() {
@@ -37,6 +72,57 @@ void DrawInputOptions() {
 
 void DrawRendererOptions() {
 	ImGui::Text("Renderer Options");
+
+	//Disabled effects add no passes, turning them off is the way to scale down for slower machines
+	PostProcessing::Settings& post = PostProcessing::GetSettings();
+	ImGui::Text("Post Processing");
+	ImGui::Checkbox("Bloom", &post.Bloom);
+	if (post.Bloom) {
+		ImGui::DragFloat("Bloom Threshold", &post.BloomThreshold, 0.01f, 0.0f, 1.0f);
+		ImGui::DragFloat("Bloom Intensity", &post.BloomIntensity, 0.01f, 0.0f, 10.0f);
+		ImGui::SliderFloat("Bloom Resolution", &post.BloomResolution, 0.1f, 1.0f);
+		ImGui::SliderInt("Bloom Iterations", &post.BloomIterations, 1, 4);
+	}
+
+	ImGui::Checkbox("Color Grading", &post.ColorGrading);
+	if (post.ColorGrading) {
+		ImGui::Text("LUT: %s", post.Lut_Path.empty() ? "None" : post.Lut_Path.c_str());
+		if (ImGui::Button("Select LUT")) {
+			std::string lut_path = FileDialogs::OpenFile(ProjectManager::GetPath(), "Image (*.png)\0*.png\0");
+			if (!lut_path.empty()) {
+				post.Lut_Path = lut_path;
+				post.Lut = Texture2D::Create(lut_path);
+			}
+		}
+		ImGui::SliderFloat("LUT Contribution", &post.LutContribution, 0.0f, 1.0f);
+	}
+
+	ImGui::Checkbox("Vignette", &post.Vignette);
+	if (post.Vignette) {
+		ImGui::SliderFloat("Vignette Intensity", &post.VignetteIntensity, 0.0f, 1.0f);
+		ImGui::SliderFloat("Vignette Smoothness", &post.VignetteSmoothness, 0.0f, 1.0f);
+	}
+
+	ImGui::Checkbox("CRT", &post.CRT);
+	if (post.CRT) {
+		ImGui::SliderFloat("Curvature", &post.CRTCurvature, 0.0f, 1.0f);
+		ImGui::SliderFloat("Scanline Intensity", &post.ScanlineIntensity, 0.0f, 1.0f);
+	}
+
+	DynamicResolution::Settings& resolution = DynamicResolution::GetSettings();
+	ImGui::Separator();
+	ImGui::Text("Dynamic Resolution");
+	ImGui::Checkbox("Enabled", &resolution.Enabled);
+	if (resolution.Enabled) {
+		ImGui::DragFloat("Target Frame Time (ms)", &resolution.TargetFrameTime, 0.1f, 1.0f, 100.0f);
+		ImGui::SliderFloat("Min Scale", &resolution.MinScale, 0.1f, 1.0f);
+		ImGui::SliderFloat("Max Scale", &resolution.MaxScale, resolution.MinScale, 1.0f);
+		ImGui::SliderFloat("Sharpness", &resolution.Sharpness, 0.0f, 1.0f);
+
+		const DynamicResolution::Statistics& stats = DynamicResolution::GetStats();
+		ImGui::Text("GPU Time: %.2f ms", stats.GPUTime);
+		ImGui::Text("Render Scale: %.0f%%", stats.Scale * 100.0f);
+	}
 }
 
 void DrawPhysicsOptions() {
@@ -55,6 +141,15 @@ void DrawPhysicsOptions() {
 	int32_t position_iterations = PhysicsEngine::s_Data.position_iterations;
 	ImGui::InputInt("Position Iterations", &position_iterations, 1, 1);
 	PhysicsEngine::s_Data.position_iterations = (uint32_t)abs(position_iterations);
+
+	//Shown as a rate, stored as the step length
+	float fixed_rate = 1.0f / PhysicsEngine::s_Data.fixed_timestep;
+	ImGui::InputFloat("Fixed Update Rate (Hz)", &fixed_rate, 1.0f, 10.0f, "%.0f");
+	PhysicsEngine::s_Data.fixed_timestep = 1.0f / std::clamp(fixed_rate, 1.0f, 1000.0f);
+
+	int32_t max_substeps = PhysicsEngine::s_Data.max_substeps;
+	ImGui::InputInt("Max Substeps", &max_substeps, 1, 1);
+	PhysicsEngine::s_Data.max_substeps = (uint32_t)std::max(max_substeps, 1);
 }
 
 void DrawScriptingOptions() {
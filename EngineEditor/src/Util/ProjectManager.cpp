@@ -1,6 +1,10 @@
 #include "ProjectManager.h"
 #include <yaml-cpp/yaml.h>
+#include "SurfEngine/Core/Application.h"
+#include "SurfEngine/Core/FramePacer.h"
 #include "SurfEngine/Physics/PhysicsEngine.h"
+#include "SurfEngine/Renderer/PostProcessing.h"
+#include "SurfEngine/Renderer/DynamicResolution.h"
 #include <fstream>
 
 
@@ -390,16 +394,50 @@ namespace SurfEngine {
 				out << YAML::Key << "Name" << YAML::Value << project_name;
 				out << YAML::Key << "Properties" << YAML::BeginMap;
 					out << YAML::Key << "General" << YAML::BeginMap;
+					{
+						const FramePacer::Settings& pacing = FramePacer::GetSettings();
+						out << YAML::Key << "vsync" << YAML::Value << Application::Get().GetWindow().IsVSync();
+						out << YAML::Key << "target_fps" << YAML::Value << pacing.TargetFPS;
+						out << YAML::Key << "background_fps" << YAML::Value << pacing.BackgroundFPS;
+						out << YAML::Key << "idle_wait" << YAML::Value << pacing.IdleWait;
+						out << YAML::Key << "idle_timeout" << YAML::Value << pacing.IdleTimeout;
+					}
 					out << YAML::EndMap;
 					out << YAML::Key << "Input" << YAML::BeginMap;
 					out << YAML::EndMap;
 					out << YAML::Key << "Renderer" << YAML::BeginMap;
+					{
+						const PostProcessing::Settings& post = PostProcessing::GetSettings();
+						out << YAML::Key << "bloom" << YAML::Value << post.Bloom;
+						out << YAML::Key << "bloom_threshold" << YAML::Value << post.BloomThreshold;
+						out << YAML::Key << "bloom_intensity" << YAML::Value << post.BloomIntensity;
+						out << YAML::Key << "bloom_resolution" << YAML::Value << post.BloomResolution;
+						out << YAML::Key << "bloom_iterations" << YAML::Value << post.BloomIterations;
+						out << YAML::Key << "color_grading" << YAML::Value << post.ColorGrading;
+						out << YAML::Key << "lut_path" << YAML::Value << post.Lut_Path;
+						out << YAML::Key << "lut_contribution" << YAML::Value << post.LutContribution;
+						out << YAML::Key << "vignette" << YAML::Value << post.Vignette;
+						out << YAML::Key << "vignette_intensity" << YAML::Value << post.VignetteIntensity;
+						out << YAML::Key << "vignette_smoothness" << YAML::Value << post.VignetteSmoothness;
+						out << YAML::Key << "crt" << YAML::Value << post.CRT;
+						out << YAML::Key << "crt_curvature" << YAML::Value << post.CRTCurvature;
+						out << YAML::Key << "scanline_intensity" << YAML::Value << post.ScanlineIntensity;
+
+						const DynamicResolution::Settings& resolution = DynamicResolution::GetSettings();
+						out << YAML::Key << "dynamic_resolution" << YAML::Value << resolution.Enabled;
+						out << YAML::Key << "target_frame_time" << YAML::Value << resolution.TargetFrameTime;
+						out << YAML::Key << "min_scale" << YAML::Value << resolution.MinScale;
+						out << YAML::Key << "max_scale" << YAML::Value << resolution.MaxScale;
+						out << YAML::Key << "sharpness" << YAML::Value << resolution.Sharpness;
+					}
 					out << YAML::EndMap;
 					out << YAML::Key << "Physics" << YAML::BeginMap;
 						out << YAML::Key << "gravity_scale_x" << YAML::Value << PhysicsEngine::s_Data.gravity_scale.x;
 						out << YAML::Key << "gravity_scale_y" << YAML::Value << PhysicsEngine::s_Data.gravity_scale.y;
 						out << YAML::Key << "velocity_iterations" << YAML::Value << PhysicsEngine::s_Data.velocity_iterations;
 						out << YAML::Key << "position_iterations" << YAML::Value << PhysicsEngine::s_Data.position_iterations;
+						out << YAML::Key << "fixed_timestep" << YAML::Value << PhysicsEngine::s_Data.fixed_timestep;
+						out << YAML::Key << "max_substeps" << YAML::Value << PhysicsEngine::s_Data.max_substeps;
 					out << YAML::EndMap;
 					out << YAML::Key << "Scripting" << YAML::BeginMap;
 						out << YAML::Key << "csc_path" << YAML::Value << ScriptEngine::s_Data->csc_path;
@@ -419,11 +457,51 @@ namespace SurfEngine {
 		data = YAML::LoadFile(CreateProjectDirectory(project_name) + "\\" + project_name + ".surf"); if (!data) { return; }	
 		auto Project = data["Project"]; if (!Project) { return; }
 		auto Properties = Project["Properties"];  if (!Properties) { return; }
+		auto GeneralProperties = Properties["General"];
+		if (GeneralProperties) {
+			FramePacer::Settings& pacing = FramePacer::GetSettings();
+			if (GeneralProperties["vsync"]) { Application::Get().GetWindow().SetVSync(GeneralProperties["vsync"].as<bool>()); }
+			if (GeneralProperties["target_fps"]) { pacing.TargetFPS = GeneralProperties["target_fps"].as<int>(); }
+			if (GeneralProperties["background_fps"]) { pacing.BackgroundFPS = GeneralProperties["background_fps"].as<int>(); }
+			if (GeneralProperties["idle_wait"]) { pacing.IdleWait = GeneralProperties["idle_wait"].as<bool>(); }
+			if (GeneralProperties["idle_timeout"]) { pacing.IdleTimeout = GeneralProperties["idle_timeout"].as<float>(); }
+		}
+
+		auto RendererProperties = Properties["Renderer"];
+		if (RendererProperties) {
+			PostProcessing::Settings& post = PostProcessing::GetSettings();
+			if (RendererProperties["bloom"]) { post.Bloom = RendererProperties["bloom"].as<bool>(); }
+			if (RendererProperties["bloom_threshold"]) { post.BloomThreshold = RendererProperties["bloom_threshold"].as<float>(); }
+			if (RendererProperties["bloom_intensity"]) { post.BloomIntensity = RendererProperties["bloom_intensity"].as<float>(); }
+			if (RendererProperties["bloom_resolution"]) { post.BloomResolution = RendererProperties["bloom_resolution"].as<float>(); }
+			if (RendererProperties["bloom_iterations"]) { post.BloomIterations = RendererProperties["bloom_iterations"].as<int>(); }
+			if (RendererProperties["color_grading"]) { post.ColorGrading = RendererProperties["color_grading"].as<bool>(); }
+			if (RendererProperties["lut_path"]) { post.Lut_Path = RendererProperties["lut_path"].as<std::string>(); }
+			if (RendererProperties["lut_contribution"]) { post.LutContribution = RendererProperties["lut_contribution"].as<float>(); }
+			if (RendererProperties["vignette"]) { post.Vignette = RendererProperties["vignette"].as<bool>(); }
+			if (RendererProperties["vignette_intensity"]) { post.VignetteIntensity = RendererProperties["vignette_intensity"].as<float>(); }
+			if (RendererProperties["vignette_smoothness"]) { post.VignetteSmoothness = RendererProperties["vignette_smoothness"].as<float>(); }
+			if (RendererProperties["crt"]) { post.CRT = RendererProperties["crt"].as<bool>(); }
+			if (RendererProperties["crt_curvature"]) { post.CRTCurvature = RendererProperties["crt_curvature"].as<float>(); }
+			if (RendererProperties["scanline_intensity"]) { post.ScanlineIntensity = RendererProperties["scanline_intensity"].as<float>(); }
+			post.Lut = post.Lut_Path.empty() ? nullptr : Texture2D::Create(post.Lut_Path);
+
+			DynamicResolution::Settings& resolution = DynamicResolution::GetSettings();
+			if (RendererProperties["dynamic_resolution"]) { resolution.Enabled = RendererProperties["dynamic_resolution"].as<bool>(); }
+			if (RendererProperties["target_frame_time"]) { resolution.TargetFrameTime = RendererProperties["target_frame_time"].as<float>(); }
+			if (RendererProperties["min_scale"]) { resolution.MinScale = RendererProperties["min_scale"].as<float>(); }
+			if (RendererProperties["max_scale"]) { resolution.MaxScale = RendererProperties["max_scale"].as<float>(); }
+			if (RendererProperties["sharpness"]) { resolution.Sharpness = RendererProperties["sharpness"].as<float>(); }
+		}
+
 		auto PhysicsProperties = Properties["Physics"]; if (!PhysicsProperties) { return; }
 		if (PhysicsProperties["gravity_scale_x"]) { PhysicsEngine::s_Data.gravity_scale.x = PhysicsProperties["gravity_scale_x"].as<float>(); }
 		if (PhysicsProperties["gravity_scale_y"]) { PhysicsEngine::s_Data.gravity_scale.y = PhysicsProperties["gravity_scale_y"].as<float>();}
 		if (PhysicsProperties["velocity_iterations"]) { PhysicsEngine::s_Data.velocity_iterations = PhysicsProperties["velocity_iterations"].as<float>();}
 		if (PhysicsProperties["position_iterations"]) { PhysicsEngine::s_Data.position_iterations = PhysicsProperties["position_iterations"].as<float>();}
+		//Same limits as the Physics menu, no substeps would freeze the simulation
+		if (PhysicsProperties["fixed_timestep"]) { PhysicsEngine::s_Data.fixed_timestep = std::clamp(PhysicsProperties["fixed_timestep"].as<float>(), 1.0f / 1000.0f, 1.0f); }
+		if (PhysicsProperties["max_substeps"]) { PhysicsEngine::s_Data.max_substeps = (uint32_t)std::max(PhysicsProperties["max_substeps"].as<int>(), 1); }
 
 		auto ScriptProperties = Properties["Scripting"]; if (!ScriptProperties) { return; }
 		if (ScriptProperties["csc_path"]) { ScriptEngine::s_Data->csc_path = ScriptProperties["csc_path"].as<std::string>(); }
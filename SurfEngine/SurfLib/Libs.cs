@@ -502,6 +502,27 @@ namespace SurfEngine {
         }
     }
 
+    public class Text : Component{
+        public override string GetComponentType()
+        {
+            return "Text";
+        }
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern string GetTextImpl(string uuid);
+        public string GetText()
+        {
+            return GetTextImpl(this.uuid.ToString());
+        }
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern void SetTextImpl(string uuid, string text);
+        public void SetText(string text)
+        {
+            SetTextImpl(this.uuid.ToString(), text);
+        }
+    }
+
     public class KeyCode
     {
         public static int SPACE = 32                ;
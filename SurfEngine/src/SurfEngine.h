@@ -12,6 +12,8 @@
 #include "SurfEngine/Core/Timestep.h"
 #include "SurfEngine/Core/UUID.h"
 #include "SurfEngine/Core/PlatformUtils.h"
+#include "SurfEngine/Core/FramePacer.h"
+#include "SurfEngine/Core/JobSystem.h"
 
 //Input
 #include "SurfEngine/Core/MouseButtonCodes.h"
@@ -22,6 +24,7 @@
 #include "SurfEngine/Renderer/renderer.h"
 #include "SurfEngine/Renderer/RenderCommand.h"
 #include "SurfEngine/Renderer/Renderer2D.h"
+#include "SurfEngine/Renderer/HeadlessRenderer.h"
 
 #include "SurfEngine/Renderer/Buffer.h"
 #include "SurfEngine/Renderer/FrameBuffer.h"
@@ -40,4 +43,5 @@
 #include "SurfEngine/Scenes/Components.h"
 #include "SurfEngine/Scenes/Object.h"
 #include "SurfEngine/Scenes/ScriptableObject.h"
-#include "SurfEngine/Scenes/SceneSerializer.h"
\ No newline at end of file
+#include "SurfEngine/Scenes/SceneSerializer.h"
+#include "SurfEngine/Scenes/SceneSnapshot.h"
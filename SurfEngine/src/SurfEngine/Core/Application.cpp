@@ -2,7 +2,10 @@
 #include "Application.h"
 #include "Layer.h"
 #include "SurfEngine/Core/Input.h"
+#include "SurfEngine/Core/FramePacer.h"
+#include "SurfEngine/Core/JobSystem.h"
 #include "SurfEngine/Renderer/Renderer.h"
+#include "SurfEngine/Renderer/RenderTargetPool.h"
 
 #include <GLFW/glfw3.h>
 
@@ -16,20 +19,27 @@ namespace SurfEngine {
 	Application::Application(){
 		SE_CORE_ASSERT(!s_Instance, "Application already exists");
 		s_Instance = this;
+		//The window, its GL context and the ImGui layer are OpenGL only, HeadlessRenderer drives the software renderer
+		SE_CORE_ASSERT(RendererAPI::GetAPI() == RendererAPI::API::OpenGL, "Application needs the OpenGL renderer");
 		m_Window = Window::Create();
 		m_Window->SetEventCallback(BIND_EVENT_FN(Application::OnEvent));
+		JobSystem::Init();
+		RenderCommand::Init();
+		FramePacer::Init();
 		
 		m_ImGuiLayer = new ImGuiLayer();
 		PushOverlay(m_ImGuiLayer);
 	}
 
 	Application::~Application(){
-
+		FramePacer::Shutdown();
+		JobSystem::Shutdown();
 	}
 
 	void Application::OnEvent(Event& e) {
 		EventDispatcher dispatcher(e);
 		dispatcher.Dispatch<WindowCloseEvent>(BIND_EVENT_FN(Application::OnWindowClose));
+		FramePacer::OnEvent(e);
 		if(DEBUG_LOG)
 			SE_CORE_TRACE("{0}", e);
 
@@ -61,8 +71,16 @@ namespace SurfEngine {
 				
 			}
 			m_ImGuiLayer->End();
+
+			//Transient render targets live until everything, including ImGui, has drawn from them
+			RenderTargetPool::EndFrame();
 		
 			m_Window->OnUpdate();
+
+			//Without a frame limit or vsync this loop would take a whole core
+			FramePacer::WaitForNextFrame(*m_Window);
+			//Utilization is measured against the whole frame, paced waits included
+			JobSystem::EndFrame();
 		}
 	}
 
@@ -0,0 +1,160 @@
+#include "sepch.h"
+#include "FramePacer.h"
+
+#include "SurfEngine/Core/PlatformUtils.h"
+#include "SurfEngine/Events/KeyEvent.h"
+#include "SurfEngine/Events/MouseEvent.h"
+
+#include <thread>
+
+namespace SurfEngine {
+
+	// Frames drawn after an input or request, ImGui needs a couple to settle hover and focus states
+	static const uint32_t s_WakeFrames = 3;
+	// Frames the statistics are taken over
+	static const uint32_t s_StatsFrames = 120;
+
+	struct FramePacerData {
+		FramePacer::Settings Settings;
+		FramePacer::Statistics Stats;
+
+		double LastFrame = 0.0;
+		double NextFrame = 0.0;
+		// How early sleeps wake up before the deadline, follows how late the OS has been waking us
+		double SpinMargin = 0.002;
+
+		uint32_t PendingFrames = s_WakeFrames;
+		int HeldInputs = 0;
+		bool WasFocused = true;
+
+		std::array<float, s_StatsFrames> FrameTimes = {};
+		uint32_t FrameTimeCount = 0;
+		uint32_t FrameTimeIndex = 0;
+	};
+
+	static FramePacerData* s_Data = nullptr;
+
+	void FramePacer::Init() {
+		s_Data = new FramePacerData();
+		s_Data->LastFrame = Time::GetTime();
+		s_Data->NextFrame = s_Data->LastFrame;
+	}
+
+	void FramePacer::Shutdown() {
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	FramePacer::Settings& FramePacer::GetSettings() {
+		return s_Data->Settings;
+	}
+
+	const FramePacer::Statistics& FramePacer::GetStats() {
+		return s_Data->Stats;
+	}
+
+	void FramePacer::RequestFrame() {
+		s_Data->PendingFrames = s_WakeFrames;
+	}
+
+	void FramePacer::OnEvent(Event& e) {
+		switch (e.GetEventType()) {
+		case EventType::KeyPressed:
+			if (((KeyPressedEvent&)e).GetRepeatCount() == 0)
+				s_Data->HeldInputs++;
+			break;
+		case EventType::MouseButtonPressed:
+			s_Data->HeldInputs++;
+			break;
+		case EventType::KeyReleased:
+		case EventType::MouseButtonReleased:
+			s_Data->HeldInputs = std::max(s_Data->HeldInputs - 1, 0);
+			break;
+		default:
+			break;
+		}
+		RequestFrame();
+	}
+
+	//Sleeps for all but the spin margin, then spins out the rest for an exact wake up
+	static void WaitUntil(double deadline) {
+		double remaining = deadline - Time::GetTime();
+		if (remaining > s_Data->SpinMargin) {
+			double requested = remaining - s_Data->SpinMargin;
+			double start = Time::GetTime();
+			Time::Sleep(requested);
+			double oversleep = Time::GetTime() - start - requested;
+			s_Data->SpinMargin = std::clamp(std::max(s_Data->SpinMargin * 0.99, oversleep * 1.25), 0.0005, 0.02);
+		}
+		while (Time::GetTime() < deadline)
+			std::this_thread::yield();
+	}
+
+	static void RecordFrameTime(float frameTime, double period) {
+		FramePacerData& data = *s_Data;
+		data.FrameTimes[data.FrameTimeIndex] = frameTime;
+		data.FrameTimeIndex = (data.FrameTimeIndex + 1) % s_StatsFrames;
+		data.FrameTimeCount = std::min(data.FrameTimeCount + 1, s_StatsFrames);
+
+		float sum = 0.0f;
+		float minTime = frameTime;
+		float maxTime = frameTime;
+		uint32_t missed = 0;
+		for (uint32_t i = 0; i < data.FrameTimeCount; i++) {
+			float time = data.FrameTimes[i];
+			sum += time;
+			minTime = std::min(minTime, time);
+			maxTime = std::max(maxTime, time);
+			if (period > 0.0 && time > period * 1500.0)
+				missed++;
+		}
+		float average = sum / data.FrameTimeCount;
+		float variance = 0.0f;
+		for (uint32_t i = 0; i < data.FrameTimeCount; i++)
+			variance += (data.FrameTimes[i] - average) * (data.FrameTimes[i] - average);
+
+		data.Stats.FrameTime = frameTime;
+		data.Stats.AverageFrameTime = average;
+		data.Stats.MinFrameTime = minTime;
+		data.Stats.MaxFrameTime = maxTime;
+		data.Stats.Jitter = std::sqrt(variance / data.FrameTimeCount);
+		data.Stats.MissedFrames = missed;
+	}
+
+	void FramePacer::WaitForNextFrame(Window& window) {
+		const Settings& settings = s_Data->Settings;
+
+		//Releases that happen while another window has focus never reach us
+		if (window.IsFocused() != s_Data->WasFocused) {
+			s_Data->WasFocused = window.IsFocused();
+			s_Data->HeldInputs = 0;
+			RequestFrame();
+		}
+
+		bool background = window.IsMinimized() || !window.IsFocused();
+		int fps = settings.TargetFPS;
+		if (background && settings.BackgroundFPS > 0)
+			fps = fps > 0 ? std::min(fps, settings.BackgroundFPS) : settings.BackgroundFPS;
+		double period = fps > 0 ? 1.0 / fps : 0.0;
+
+		bool idle = settings.IdleWait && s_Data->PendingFrames == 0 && s_Data->HeldInputs == 0;
+		if (idle)
+			window.WaitEvents(std::max(settings.IdleTimeout, 0.001f));
+		else if (fps > 0)
+			WaitUntil(s_Data->NextFrame);
+		if (s_Data->PendingFrames > 0)
+			s_Data->PendingFrames--;
+
+		double now = Time::GetTime();
+		//Falling more than a period behind starts the cadence over instead of rushing frames to catch up
+		s_Data->NextFrame += period;
+		if (s_Data->NextFrame <= now)
+			s_Data->NextFrame = now + period;
+
+		if (!idle)
+			RecordFrameTime((float)((now - s_Data->LastFrame) * 1000.0), period);
+		s_Data->LastFrame = now;
+		s_Data->Stats.Background = background;
+		s_Data->Stats.Idle = idle;
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "SurfEngine/Core/Window.h"
+#include "SurfEngine/Events/Event.h"
+
+namespace SurfEngine {
+
+	// Holds the main loop to a target frame rate, sleeping for most of the wait and spinning the rest
+	// Minimized or unfocused windows drop to a background rate, and with IdleWait the loop blocks on
+	// window events while nothing is happening instead of drawing identical frames
+	class FramePacer {
+	public:
+		struct Settings {
+			// 0 leaves the rate to vsync
+			int TargetFPS = 0;
+			// Rate while the window is minimized or unfocused, 0 keeps the normal rate
+			int BackgroundFPS = 15;
+			// Blocks on window events when no input arrived and nothing requested a frame
+			bool IdleWait = false;
+			// Longest idle wait in seconds, the loop still ticks this often without events
+			float IdleTimeout = 0.5f;
+		};
+
+		// Milliseconds over the last frames, frames that followed an idle wait are left out
+		struct Statistics {
+			float FrameTime = 0.0f;
+			float AverageFrameTime = 0.0f;
+			float MinFrameTime = 0.0f;
+			float MaxFrameTime = 0.0f;
+			// Standard deviation of the frame time
+			float Jitter = 0.0f;
+			// Frames that took longer than one and a half target periods
+			uint32_t MissedFrames = 0;
+			bool Background = false;
+			bool Idle = false;
+		};
+	public:
+		static void Init();
+		static void Shutdown();
+
+		static Settings& GetSettings();
+		static const Statistics& GetStats();
+
+		// Keeps the loop drawing for the next few frames, for anything that changes without input
+		static void RequestFrame();
+		// Input keeps the loop awake, held keys and buttons until they are released
+		static void OnEvent(Event& e);
+
+		// Called once the frame is presented, returns when the next one is due
+		static void WaitForNextFrame(Window& window);
+	};
+}
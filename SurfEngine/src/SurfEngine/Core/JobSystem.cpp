@@ -0,0 +1,226 @@
+#include "sepch.h"
+#include "JobSystem.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace SurfEngine {
+
+	struct QueuedJob {
+		JobSystem::Job Function;
+		JobSystem::Counter* Counter = nullptr;
+		JobSystem::Counter* Dependency = nullptr;
+	};
+
+	// The owner works at the back, thieves take from the front
+	struct JobQueue {
+		std::mutex Mutex;
+		std::deque<QueuedJob> Jobs;
+	};
+
+	struct WorkerTimes {
+		std::atomic<uint64_t> BusyNanoseconds{ 0 };
+		std::atomic<uint32_t> Executed{ 0 };
+		std::atomic<uint32_t> Stolen{ 0 };
+	};
+
+	struct JobSystemData {
+		std::vector<std::thread> Workers;
+		// One queue per worker and a last one shared by every other thread
+		std::vector<std::unique_ptr<JobQueue>> Queues;
+		std::vector<std::unique_ptr<WorkerTimes>> Times;
+
+		std::atomic<uint32_t> Queued{ 0 };
+		std::atomic<bool> Running{ true };
+		std::mutex WakeMutex;
+		std::condition_variable Wake;
+
+		std::chrono::steady_clock::time_point FrameStart;
+		JobSystem::Statistics Stats;
+	};
+
+	static JobSystemData* s_Data = nullptr;
+
+	// Index of the calling thread's queue, threads that are not workers leave it unset
+	static thread_local uint32_t s_QueueIndex = UINT32_MAX;
+	// Jobs run inside a job are already timed by the outer one
+	static thread_local uint32_t s_JobDepth = 0;
+
+	static uint32_t GetQueueIndex() {
+		return s_QueueIndex != UINT32_MAX ? s_QueueIndex : (uint32_t)s_Data->Workers.size();
+	}
+
+	static bool PopJob(uint32_t index, QueuedJob& job) {
+		const uint32_t queues = (uint32_t)s_Data->Queues.size();
+		{
+			JobQueue& own = *s_Data->Queues[index];
+			std::lock_guard<std::mutex> lock(own.Mutex);
+			if (!own.Jobs.empty()) {
+				job = std::move(own.Jobs.back());
+				own.Jobs.pop_back();
+				s_Data->Queued--;
+				return true;
+			}
+		}
+
+		for (uint32_t i = 1; i < queues; i++) {
+			JobQueue& victim = *s_Data->Queues[(index + i) % queues];
+			std::lock_guard<std::mutex> lock(victim.Mutex);
+			if (!victim.Jobs.empty()) {
+				job = std::move(victim.Jobs.front());
+				victim.Jobs.pop_front();
+				s_Data->Queued--;
+				s_Data->Times[index]->Stolen++;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	static void Execute(QueuedJob& job, uint32_t index) {
+		WorkerTimes& times = *s_Data->Times[index];
+		auto start = std::chrono::steady_clock::now();
+		s_JobDepth++;
+		job.Function();
+		s_JobDepth--;
+		if (s_JobDepth == 0)
+			times.BusyNanoseconds += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+		times.Executed++;
+
+		if (job.Counter)
+			job.Counter->Pending.fetch_sub(1, std::memory_order_release);
+	}
+
+	// Goes to the end of the queue the owner reaches last, so ready jobs are taken first
+	static void Requeue(uint32_t index, QueuedJob& job) {
+		JobQueue& queue = *s_Data->Queues[index];
+		std::lock_guard<std::mutex> lock(queue.Mutex);
+		queue.Jobs.push_front(std::move(job));
+		s_Data->Queued++;
+	}
+
+	//Jobs never block on their dependency, the job it waits for could be suspended further down this thread's stack
+	//One that is not ready yet is put back and the caller moves on
+	static bool RunOne(uint32_t index) {
+		QueuedJob job;
+		if (!PopJob(index, job))
+			return false;
+		if (job.Dependency && !job.Dependency->IsDone()) {
+			Requeue(index, job);
+			return false;
+		}
+		Execute(job, index);
+		return true;
+	}
+
+	static void WorkerLoop(uint32_t index) {
+		s_QueueIndex = index;
+		while (s_Data->Running) {
+			if (RunOne(index))
+				continue;
+
+			//Queued jobs may all be waiting on dependencies that are still running
+			std::this_thread::yield();
+			std::unique_lock<std::mutex> lock(s_Data->WakeMutex);
+			s_Data->Wake.wait(lock, []() { return s_Data->Queued > 0 || !s_Data->Running; });
+		}
+	}
+
+	void JobSystem::Init(uint32_t workers) {
+		s_Data = new JobSystemData();
+		if (workers == 0)
+			workers = std::max(std::thread::hardware_concurrency(), 1u) - 1;
+
+		for (uint32_t i = 0; i <= workers; i++) {
+			s_Data->Queues.push_back(std::make_unique<JobQueue>());
+			s_Data->Times.push_back(std::make_unique<WorkerTimes>());
+		}
+		//Queues and times are all in place before the first worker looks at them
+		s_Data->Workers.reserve(workers);
+		for (uint32_t i = 0; i < workers; i++)
+			s_Data->Workers.emplace_back(WorkerLoop, i);
+
+		s_Data->Stats.Workers = workers;
+		s_Data->Stats.WorkerUtilization.assign(workers, 0.0f);
+		s_Data->FrameStart = std::chrono::steady_clock::now();
+		SE_CORE_INFO("Job system started with {0} workers", workers);
+	}
+
+	//Jobs still queued are dropped, whoever queued them is expected to have waited
+	void JobSystem::Shutdown() {
+		{
+			std::lock_guard<std::mutex> lock(s_Data->WakeMutex);
+			s_Data->Running = false;
+		}
+		s_Data->Wake.notify_all();
+		for (std::thread& worker : s_Data->Workers)
+			worker.join();
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	uint32_t JobSystem::GetWorkerCount() {
+		return s_Data ? (uint32_t)s_Data->Workers.size() : 0;
+	}
+
+	void JobSystem::Run(Job job, Counter* counter, Counter* dependency) {
+		if (counter)
+			counter->Pending.fetch_add(1, std::memory_order_relaxed);
+
+		if (!s_Data || s_Data->Workers.empty()) {
+			if (dependency)
+				Wait(*dependency);
+			job();
+			if (counter)
+				counter->Pending.fetch_sub(1, std::memory_order_release);
+			return;
+		}
+
+		JobQueue& queue = *s_Data->Queues[GetQueueIndex()];
+		{
+			std::lock_guard<std::mutex> lock(queue.Mutex);
+			queue.Jobs.push_back({ std::move(job), counter, dependency });
+			s_Data->Queued++;
+		}
+		//Taking the lock orders the push before a worker that is about to check the queue goes to sleep
+		{ std::lock_guard<std::mutex> lock(s_Data->WakeMutex); }
+		s_Data->Wake.notify_one();
+	}
+
+	void JobSystem::Wait(Counter& counter) {
+		while (!counter.IsDone()) {
+			if (!s_Data || !RunOne(GetQueueIndex()))
+				std::this_thread::yield();
+		}
+	}
+
+	void JobSystem::EndFrame() {
+		auto now = std::chrono::steady_clock::now();
+		double frame = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(now - s_Data->FrameStart).count();
+		s_Data->FrameStart = now;
+
+		Statistics& stats = s_Data->Stats;
+		stats.JobsExecuted = 0;
+		stats.JobsStolen = 0;
+		stats.Utilization = 0.0f;
+		for (uint32_t i = 0; i < (uint32_t)s_Data->Times.size(); i++) {
+			WorkerTimes& times = *s_Data->Times[i];
+			uint64_t busy = times.BusyNanoseconds.exchange(0);
+			stats.JobsExecuted += times.Executed.exchange(0);
+			stats.JobsStolen += times.Stolen.exchange(0);
+			if (i < stats.Workers) {
+				stats.WorkerUtilization[i] = frame > 0.0 ? (float)std::min(busy / frame, 1.0) : 0.0f;
+				stats.Utilization += stats.WorkerUtilization[i];
+			}
+		}
+		if (stats.Workers > 0)
+			stats.Utilization /= stats.Workers;
+	}
+
+	const JobSystem::Statistics& JobSystem::GetStats() {
+		return s_Data->Stats;
+	}
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+namespace SurfEngine {
+
+	// One worker thread per core besides the main thread, each with its own deque of jobs
+	// Workers take their newest job first and steal the oldest ones of the others when they run dry
+	// Threads waiting on a counter run queued jobs meanwhile, so jobs can fan out and wait on more jobs
+	class JobSystem {
+	public:
+		using Job = std::function<void()>;
+
+		// Jobs of a group still to finish, it has to outlive them
+		struct Counter {
+			std::atomic<uint32_t> Pending{ 0 };
+
+			bool IsDone() const { return Pending.load(std::memory_order_acquire) == 0; }
+		};
+
+		struct Statistics {
+			uint32_t Workers = 0;
+			// Over the last frame, jobs run by waiting threads included
+			uint32_t JobsExecuted = 0;
+			uint32_t JobsStolen = 0;
+			// Share of the last frame each worker spent running jobs, and their average
+			std::vector<float> WorkerUtilization;
+			float Utilization = 0.0f;
+		};
+	public:
+		// 0 workers starts one per hardware thread, less the main thread
+		static void Init(uint32_t workers = 0);
+		static void Shutdown();
+
+		// 0 before Init or on single core machines, everything then runs on the calling thread
+		static uint32_t GetWorkerCount();
+
+		// The counter goes up now and down once the job ran, a job with a dependency stays queued until it is done
+		static void Run(Job job, Counter* counter = nullptr, Counter* dependency = nullptr);
+		// Runs queued jobs on the calling thread until the counter is done
+		static void Wait(Counter& counter);
+
+		// Calls func(begin, end) over [0, count) in ranges of at least grain items and returns once all ran
+		template<typename Func>
+		static void ParallelFor(uint32_t count, uint32_t grain, const Func& func);
+
+		// Calls func(entity) for every entity of an entt view or group
+		// Components can be read and written but not added or removed, that moves storage under the other workers
+		template<typename View, typename Func>
+		static void ParallelForEach(const View& view, uint32_t grain, const Func& func);
+
+		// Closes the frame's statistics, called once per frame by the application
+		static void EndFrame();
+		static const Statistics& GetStats();
+	};
+
+	template<typename Func>
+	void JobSystem::ParallelFor(uint32_t count, uint32_t grain, const Func& func) {
+		grain = std::max(grain, 1u);
+		uint32_t workers = GetWorkerCount();
+		if (count <= grain || workers == 0) {
+			if (count > 0)
+				func(0u, count);
+			return;
+		}
+
+		//A few ranges per thread keeps them balanced when some take longer
+		uint32_t ranges = std::min((count + grain - 1) / grain, (workers + 1) * 4);
+		uint32_t rangeSize = (count + ranges - 1) / ranges;
+		Counter counter;
+		for (uint32_t begin = rangeSize; begin < count; begin += rangeSize) {
+			uint32_t end = std::min(begin + rangeSize, count);
+			Run([&func, begin, end]() { func(begin, end); }, &counter);
+		}
+		func(0u, std::min(rangeSize, count));
+		Wait(counter);
+	}
+
+	template<typename View, typename Func>
+	void JobSystem::ParallelForEach(const View& view, uint32_t grain, const Func& func) {
+		std::vector<typename View::entity_type> entities(view.begin(), view.end());
+		ParallelFor((uint32_t)entities.size(), grain, [&](uint32_t begin, uint32_t end) {
+			for (uint32_t i = begin; i < end; i++)
+				func(entities[i]);
+		});
+	}
+}
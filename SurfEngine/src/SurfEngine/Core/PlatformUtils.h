@@ -13,5 +13,14 @@ namespace SurfEngine {
 		static void OpenExplorer(const std::string& path);
 	};
 
+	class Time
+	{
+	public:
+		// Seconds since the window system started
+		static double GetTime();
+		// Blocks the thread for about the given seconds, uses a high resolution timer where the OS has one
+		static void Sleep(double seconds);
+	};
+
 }
 
@@ -32,6 +32,11 @@ namespace SurfEngine {
 		virtual void SetEventCallback(const EventCallbackFn& callback) = 0;
 		virtual void SetVSync(bool enabled) = 0;
 		virtual bool IsVSync() const = 0;
+		virtual bool IsFocused() const = 0;
+		virtual bool IsMinimized() const = 0;
+
+		// Sleeps until an event arrives or timeout seconds pass, events are dispatched like in OnUpdate
+		virtual void WaitEvents(double timeout) = 0;
 		
 		virtual void* GetNativeWindow() const = 0;
 
@@ -48,6 +48,8 @@ namespace SurfEngine {
 			body->SetFixedRotation(rb2d.FixedRotation);
 
 			rb2d.RuntimeBody = body;
+			rb2d.PreviousPosition = rb2d.CurrentPosition = { transform.Translation.x, transform.Translation.y };
+			rb2d.PreviousAngle = rb2d.CurrentAngle = transform.Rotation.z;
 
 			if (object.HasComponent<BoxColliderComponent>())
 			{
@@ -91,19 +93,35 @@ namespace SurfEngine {
 	void PhysicsEngine::OnPhysics2DUpdate(Timestep ts, Scene* scene) {
 		m_PhysicsWorld->Step(ts, s_Data.velocity_iterations, s_Data.position_iterations);
 
-		// Retrieve transform from Box2D
+		// Retrieve poses from Box2D, the transforms are written once per frame by InterpolateTransforms
 		auto view = scene->GetRegistry()->view<RigidbodyComponent>();
 		for (auto o : view)
 		{
-			Object object = { o, scene };
-			auto& transform = object.GetComponent<TransformComponent>();
-			auto& rb2d = object.GetComponent<RigidbodyComponent>();
+			auto& rb2d = view.get<RigidbodyComponent>(o);
 
 			b2Body* body = (b2Body*)rb2d.RuntimeBody;
 			const auto& position = body->GetPosition();
+			rb2d.PreviousPosition = rb2d.CurrentPosition;
+			rb2d.PreviousAngle = rb2d.CurrentAngle;
+			rb2d.CurrentPosition = { position.x, -position.y };
+			rb2d.CurrentAngle = -glm::degrees(body->GetAngle());
+		}
+	}
+
+	void PhysicsEngine::InterpolateTransforms(Scene* scene, float alpha) {
+		auto view = scene->GetRegistry()->view<RigidbodyComponent, TransformComponent>();
+		for (auto o : view)
+		{
+			auto [rb2d, transform] = view.get<RigidbodyComponent, TransformComponent>(o);
+			if (rb2d.Type == RigidbodyComponent::BodyType::Static)
+				continue;
+
+			//Box2D angles are not wrapped, so a plain lerp takes the short way
+			glm::vec2 position = glm::mix(rb2d.PreviousPosition, rb2d.CurrentPosition, alpha);
 			transform.Translation.x = position.x;
-			transform.Translation.y = -position.y;
-			transform.Rotation.z = -glm::degrees(body->GetAngle());
+			transform.Translation.y = position.y;
+			transform.Rotation.z = glm::mix(rb2d.PreviousAngle, rb2d.CurrentAngle, alpha);
+			transform.MarkDirty();
 		}
 	}
 }
\ No newline at end of file
@@ -11,6 +11,10 @@ namespace SurfEngine {
 		glm::vec2 gravity_scale = {0.0f,-9.8f};
 		uint32_t velocity_iterations = 6;
 		uint32_t position_iterations = 2;
+		// Physics and OnFixedUpdate run in steps of this length whatever the frame rate
+		float fixed_timestep = 1.0f / 60.0f;
+		// Steps run in one frame at most, the time a hitch leaves beyond that is dropped instead of caught up
+		uint32_t max_substeps = 5;
 	};
 
 	class PhysicsEngine
@@ -18,7 +22,10 @@ namespace SurfEngine {
 	public:
 		static void OnPhysics2DStart(Scene* scene);
 		static void OnPhysics2DStop();
+		// Steps the world by one fixed step and keeps the last two poses of every body
 		static void OnPhysics2DUpdate(Timestep ts, Scene* scene);
+		// Moves the transforms of moving bodies between their last two poses, alpha being how far into the next step the frame is
+		static void InterpolateTransforms(Scene* scene, float alpha);
 	public:
 		static PhysicsData s_Data;
 	private:
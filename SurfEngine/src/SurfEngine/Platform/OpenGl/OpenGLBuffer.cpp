@@ -11,6 +11,12 @@ namespace SurfEngine {
 
 	}
 
+	OpenGLVertexBuffer::OpenGLVertexBuffer(uint32_t size) {
+		glCreateBuffers(1, &m_RendererID);
+		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+		glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+	}
+
 	OpenGLVertexBuffer::~OpenGLVertexBuffer() {
 	    glDeleteBuffers(1, &m_RendererID);
 	}
@@ -24,6 +30,10 @@ namespace SurfEngine {
 		glBindBuffer(GL_ARRAY_BUFFER, 0);
 	}
 
+	void OpenGLVertexBuffer::SetData(const void* data, uint32_t size) {
+		glNamedBufferSubData(m_RendererID, 0, size, data);
+	}
+
 	//INDEX BUFFER
 
 	OpenGLIndexBuffer::OpenGLIndexBuffer(uint32_t* indices, uint32_t count) :m_Count(count) {
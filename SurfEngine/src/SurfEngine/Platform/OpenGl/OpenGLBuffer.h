@@ -6,6 +6,7 @@ namespace SurfEngine {
 	{
 	public:
 		OpenGLVertexBuffer(float* vertices, uint32_t size);
+		OpenGLVertexBuffer(uint32_t size);
 		virtual ~OpenGLVertexBuffer();
 
 		virtual void Bind() const override;
@@ -13,6 +14,7 @@ namespace SurfEngine {
 		virtual const BufferLayout& GetLayout() const override { return m_Layout; }
 		virtual void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
 
+		virtual void SetData(const void* data, uint32_t size) override;
 	private:
 		uint32_t m_RendererID;
 		BufferLayout m_Layout;
@@ -6,6 +6,8 @@ namespace SurfEngine {
 
 
 	static const uint32_t s_MaxFramebufferSize = 8192;
+	// Allocations grow in steps of this many pixels
+	static const uint32_t s_AllocationGranularity = 64;
 
 	namespace Utils {
 
@@ -101,6 +103,8 @@ namespace SurfEngine {
 				m_DepthAttachmentSpecification = spec;
 		}
 
+		m_AllocatedWidth = m_Specification.Width;
+		m_AllocatedHeight = m_Specification.Height;
 		Invalidate();
 	}
 
@@ -140,10 +144,10 @@ namespace SurfEngine {
 				switch (m_ColorAttachmentSpecifications[i].TextureFormat)
 				{
 				case FramebufferTextureFormat::RGBA8:
-					Utils::AttachColorTexture(m_ColorAttachments[i], m_Specification.Samples, GL_RGBA8, GL_RGBA, m_Specification.Width, m_Specification.Height, (GLsizei)i);
+					Utils::AttachColorTexture(m_ColorAttachments[i], m_Specification.Samples, GL_RGBA8, GL_RGBA, m_AllocatedWidth, m_AllocatedHeight, (GLsizei)i);
 					break;
 				case FramebufferTextureFormat::RED_INTEGER:
-					Utils::AttachColorTexture(m_ColorAttachments[i], m_Specification.Samples, GL_R32I, GL_RED_INTEGER, m_Specification.Width, m_Specification.Height, (GLsizei)i);
+					Utils::AttachColorTexture(m_ColorAttachments[i], m_Specification.Samples, GL_R32I, GL_RED_INTEGER, m_AllocatedWidth, m_AllocatedHeight, (GLsizei)i);
 					break;
 				}
 			}
@@ -156,7 +160,7 @@ namespace SurfEngine {
 			switch (m_DepthAttachmentSpecification.TextureFormat)
 			{
 			case FramebufferTextureFormat::DEPTH24STENCIL8:
-				Utils::AttachDepthTexture(m_DepthAttachment, m_Specification.Samples, GL_DEPTH24_STENCIL8, GL_DEPTH_STENCIL_ATTACHMENT, m_Specification.Width, m_Specification.Height);
+				Utils::AttachDepthTexture(m_DepthAttachment, m_Specification.Samples, GL_DEPTH24_STENCIL8, GL_DEPTH_STENCIL_ATTACHMENT, m_AllocatedWidth, m_AllocatedHeight);
 				break;
 			}
 		}
@@ -182,10 +186,20 @@ namespace SurfEngine {
 	{
 		glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
 		glViewport(0, 0, m_Specification.Width, m_Specification.Height);
+
+		//Keep clears inside the used part of an over-allocated framebuffer
+		if (m_Specification.Width != m_AllocatedWidth || m_Specification.Height != m_AllocatedHeight) {
+			glEnable(GL_SCISSOR_TEST);
+			glScissor(0, 0, m_Specification.Width, m_Specification.Height);
+		}
+		else {
+			glDisable(GL_SCISSOR_TEST);
+		}
 	}
 
 	void OpenGLFramebuffer::Unbind()
 	{
+		glDisable(GL_SCISSOR_TEST);
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
 	}
 
@@ -199,6 +213,21 @@ namespace SurfEngine {
 		m_Specification.Width = width;
 		m_Specification.Height = height;
 
+		//Reuse the current attachments while the new size fits and does not waste more than half of them
+		bool fits = width <= m_AllocatedWidth && height <= m_AllocatedHeight;
+		bool wasteful = width < m_AllocatedWidth / 2 || height < m_AllocatedHeight / 2;
+		if (fits && !wasteful)
+			return;
+
+		//Over-allocate when growing so dragging a size out does not reallocate every frame
+		auto allocationSize = [](uint32_t size, uint32_t current) {
+			uint32_t target = size > current ? size + size / 8 : size;
+			target = (target + s_AllocationGranularity - 1) / s_AllocationGranularity * s_AllocationGranularity;
+			return std::min(std::max(target, size), s_MaxFramebufferSize);
+		};
+		m_AllocatedWidth = allocationSize(width, m_AllocatedWidth);
+		m_AllocatedHeight = allocationSize(height, m_AllocatedHeight);
+
 		Invalidate();
 	}
 
@@ -218,7 +247,7 @@ namespace SurfEngine {
 		SE_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size());
 
 		auto& spec = m_ColorAttachmentSpecifications[attachmentIndex];
-		glClearTexImage(m_ColorAttachments[attachmentIndex], 0,
+		glClearTexSubImage(m_ColorAttachments[attachmentIndex], 0, 0, 0, 0, m_Specification.Width, m_Specification.Height, 1,
 			Utils::HazelFBTextureFormatToGL(spec.TextureFormat), GL_INT, &value);
 	}
 
@@ -23,9 +23,11 @@ namespace SurfEngine {
 		virtual uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const override { SE_CORE_ASSERT(index < m_ColorAttachments.size()); return m_ColorAttachments[index]; }
 
 		virtual const FramebufferSpecification& GetSpecification() const override { return m_Specification; }
+		virtual glm::vec2 GetUVScale() const override { return { (float)m_Specification.Width / m_AllocatedWidth, (float)m_Specification.Height / m_AllocatedHeight }; }
 	private:
 		uint32_t m_RendererID = 0;
 		FramebufferSpecification m_Specification;
+		uint32_t m_AllocatedWidth = 0, m_AllocatedHeight = 0;
 
 		std::vector<FramebufferTextureSpecification> m_ColorAttachmentSpecifications;
 		FramebufferTextureSpecification m_DepthAttachmentSpecification = FramebufferTextureFormat::None;
@@ -25,18 +25,56 @@ namespace SurfEngine {
 		glEnable(GL_DEPTH_TEST);
 	 }
 
+	 void OpenGLRendererAPI::SetDepthMode(RendererAPI::DepthMode mode) {
+		 switch (mode) {
+		 case RendererAPI::DepthMode::Off:
+			 glDisable(GL_DEPTH_TEST);
+			 glDepthMask(GL_TRUE);
+			 break;
+		 case RendererAPI::DepthMode::TestAndWrite:
+			 glEnable(GL_DEPTH_TEST);
+			 glDepthFunc(GL_LESS);
+			 glDepthMask(GL_TRUE);
+			 break;
+		 case RendererAPI::DepthMode::Test:
+			 glEnable(GL_DEPTH_TEST);
+			 glDepthFunc(GL_LESS);
+			 glDepthMask(GL_FALSE);
+			 break;
+		 }
+	 }
+
 	 void  OpenGLRendererAPI::EnableBlending() {
 		 glEnable(GL_BLEND);
 		 glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 	 }
 
+	 void OpenGLRendererAPI::SetBlendMode(RendererAPI::BlendMode mode) {
+		 switch (mode) {
+		 case RendererAPI::BlendMode::Alpha:
+			 glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			 break;
+		 case RendererAPI::BlendMode::PremultipliedAlpha:
+			 glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+			 break;
+		 case RendererAPI::BlendMode::AlphaToPremultiplied:
+			 glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+			 break;
+		 }
+	 }
+
 	 void OpenGLRendererAPI::BindTextureId(int slot, uint32_t id) {
 		 glBindTextureUnit(slot, id);
 	 }
 
-	 void OpenGLRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray){
-		glDrawElements(GL_TRIANGLES, vertexArray->GetIndexBuffer()->GetCount(), GL_UNSIGNED_INT, nullptr);
-		 glDrawElements(GL_LINES, vertexArray->GetIndexBuffer()->GetCount(), GL_UNSIGNED_INT, nullptr);
+	 void OpenGLRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount){
+		 uint32_t count = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
+		glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr);
+		 glDrawElements(GL_LINES, count, GL_UNSIGNED_INT, nullptr);
+	 }
+
+	 void OpenGLRendererAPI::DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t instanceCount) {
+		 glDrawElementsInstanced(GL_TRIANGLES, vertexArray->GetIndexBuffer()->GetCount(), GL_UNSIGNED_INT, nullptr, instanceCount);
 	 }
 
 	 void OpenGLRendererAPI::DrawLine(const Ref<VertexArray>& vertexArray) {
@@ -45,6 +83,45 @@ namespace SurfEngine {
 		 glDrawArrays(GL_LINES, 0, 2);
 	 }
 
+	 void OpenGLRendererAPI::BeginGPUTimer() {
+		 if (!m_TimerQueries[0])
+			 glGenQueries(s_TimerQueryCount, m_TimerQueries);
+
+		 //Every query still waiting on the GPU, skip this frame rather than stall
+		 GetGPUTime();
+		 if (m_TimersPending == s_TimerQueryCount)
+			 return;
+
+		 glBeginQuery(GL_TIME_ELAPSED, m_TimerQueries[m_TimerWrite]);
+		 m_TimerActive = true;
+	 }
+
+	 void OpenGLRendererAPI::EndGPUTimer() {
+		 if (!m_TimerActive)
+			 return;
+
+		 glEndQuery(GL_TIME_ELAPSED);
+		 m_TimerActive = false;
+		 m_TimerWrite = (m_TimerWrite + 1) % s_TimerQueryCount;
+		 m_TimersPending++;
+	 }
+
+	 float OpenGLRendererAPI::GetGPUTime() {
+		 while (m_TimersPending > 0) {
+			 uint32_t oldest = (m_TimerWrite + s_TimerQueryCount - m_TimersPending) % s_TimerQueryCount;
+			 GLint available = 0;
+			 glGetQueryObjectiv(m_TimerQueries[oldest], GL_QUERY_RESULT_AVAILABLE, &available);
+			 if (!available)
+				 break;
+
+			 GLuint64 nanoseconds = 0;
+			 glGetQueryObjectui64v(m_TimerQueries[oldest], GL_QUERY_RESULT, &nanoseconds);
+			 m_GPUTime = (float)(nanoseconds / 1000000.0);
+			 m_TimersPending--;
+		 }
+		 return m_GPUTime;
+	 }
+
 	 void OpenGLRendererAPI::SetWireFrameMode(RendererAPI::WireFrameMode mode) {
 		 glLineWidth(2.f);
 		 if (mode == RendererAPI::WireFrameMode::On) {
@@ -13,10 +13,23 @@ namespace SurfEngine {
 		virtual void EnableDepth() override;
 		virtual void BindTextureId(int slot, uint32_t id) override;
 		virtual void EnableBlending() override;
+		virtual void SetDepthMode(DepthMode mode) override;
+		virtual void SetBlendMode(RendererAPI::BlendMode mode) override;
 		virtual void SetWireFrameMode(RendererAPI::WireFrameMode mode) override;
-		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray) override;
+		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0) override;
+		virtual void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t instanceCount) override;
 		virtual void DrawLine(const Ref<VertexArray>& vertexArray) override;
-
+		virtual void BeginGPUTimer() override;
+		virtual void EndGPUTimer() override;
+		virtual float GetGPUTime() override;
+	private:
+		static const uint32_t s_TimerQueryCount = 4;
+		// Ring of GL_TIME_ELAPSED queries, the oldest pending ones are read back once they are available
+		uint32_t m_TimerQueries[s_TimerQueryCount] = {};
+		uint32_t m_TimerWrite = 0;
+		uint32_t m_TimersPending = 0;
+		bool m_TimerActive = false;
+		float m_GPUTime = -1.0f;
 	};
 }
 
@@ -49,16 +49,49 @@ namespace SurfEngine {
 			glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
 			glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, dataFormat, GL_UNSIGNED_BYTE, data);
+			m_AlphaMode = AnalyzeAlpha(data, m_Width * m_Height, channels);
+			m_AlphaCoverage = BuildAlphaCoverage(data, m_Width, m_Height, channels);
 
 			stbi_image_free(data);
 		}
 	}
 
-	
+	OpenGLTexture2D::OpenGLTexture2D(uint32_t width, uint32_t height, Format format)
+		: m_Width(width), m_Height(height), m_Format(format)
+	{
+		m_InternalFormat = format == Format::RGBA32F ? GL_RGBA32F : GL_RGBA8;
+		m_DataFormat = GL_RGBA;
+
+		glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
+		glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Width, m_Height);
+
+		GLenum filter = format == Format::RGBA32F ? GL_NEAREST : GL_LINEAR;
+		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, filter);
+		glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, filter);
+
+		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	}
+
 	OpenGLTexture2D::~OpenGLTexture2D() {
 		glDeleteTextures(1, &m_RendererID);
 	}
 
+	void OpenGLTexture2D::SetData(void* data, uint32_t size) {
+		if (m_Format == Format::RGBA32F) {
+			SE_CORE_ASSERT(size == m_Width * m_Height * 4 * sizeof(float), "Data must be entire texture!");
+			glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_FLOAT, data);
+			m_IsLoaded = true;
+			return;
+		}
+
+		SE_CORE_ASSERT(size == m_Width * m_Height * 4, "Data must be entire texture!");
+		glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, data);
+		m_IsLoaded = true;
+		m_AlphaMode = AnalyzeAlpha((const unsigned char*)data, m_Width * m_Height, 4);
+		m_AlphaCoverage = BuildAlphaCoverage((const unsigned char*)data, m_Width, m_Height, 4);
+	}
+
 	void OpenGLTexture2D::Bind(uint32_t slot) const {
 		glBindTextureUnit(slot, m_RendererID);
 	}
@@ -7,11 +7,16 @@ namespace SurfEngine {
 	{
 	public:
 		OpenGLTexture2D(const std::string& path);
+		OpenGLTexture2D(uint32_t width, uint32_t height, Format format);
 		virtual ~OpenGLTexture2D();
 
 		virtual uint32_t GetWidth() const  override { return m_Width; }
 		virtual uint32_t GetHeight() const override { return m_Height; }
 		virtual uint32_t GetRendererID() const override { return m_RendererID; }
+		virtual AlphaMode GetAlphaMode() const override { return m_AlphaMode; }
+		virtual const AlphaCoverage& GetAlphaCoverage() const override { return m_AlphaCoverage; }
+
+		virtual void SetData(void* data, uint32_t size) override;
 
 		virtual void Bind(uint32_t slot) const override;
 	private:
@@ -20,6 +25,9 @@ namespace SurfEngine {
 		uint32_t m_Width, m_Height;
 		uint32_t m_RendererID;
 		GLenum m_InternalFormat, m_DataFormat;
+		Format m_Format = Format::RGBA8;
+		AlphaMode m_AlphaMode = AlphaMode::Translucent;
+		AlphaCoverage m_AlphaCoverage;
 	};
 }
 
@@ -19,6 +19,7 @@ namespace SurfEngine {
 		virtual const Ref<IndexBuffer>& GetIndexBuffer() const  { return m_IndexBuffer; };
 	private:
 		uint32_t m_RendererID;
+		uint32_t m_VertexBufferIndex = 0;
 		std::vector<Ref<VertexBuffer>> m_VertexBuffers;
 		Ref<IndexBuffer> m_IndexBuffer;
 	};
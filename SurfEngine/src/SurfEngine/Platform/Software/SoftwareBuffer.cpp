@@ -0,0 +1,26 @@
+#include "sepch.h"
+#include "SoftwareBuffer.h"
+
+namespace SurfEngine {
+	SoftwareVertexBuffer::SoftwareVertexBuffer(float* vertices, uint32_t size)
+		: m_Data(vertices, vertices + size / sizeof(float))
+	{
+	}
+
+	SoftwareVertexBuffer::SoftwareVertexBuffer(uint32_t size)
+		: m_Data(size / sizeof(float), 0.0f)
+	{
+	}
+
+	void SoftwareVertexBuffer::SetData(const void* data, uint32_t size) {
+		SE_CORE_ASSERT(size <= m_Data.size() * sizeof(float), "Vertex buffer data does not fit");
+		memcpy(m_Data.data(), data, size);
+	}
+
+	//INDEX BUFFER
+
+	SoftwareIndexBuffer::SoftwareIndexBuffer(uint32_t* indices, uint32_t count)
+		: m_Indices(indices, indices + count)
+	{
+	}
+}
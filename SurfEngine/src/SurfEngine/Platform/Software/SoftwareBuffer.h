@@ -0,0 +1,41 @@
+#pragma once
+#include "SurfEngine/Renderer/Buffer.h"
+
+namespace SurfEngine {
+	class SoftwareVertexBuffer : public VertexBuffer
+	{
+	public:
+		SoftwareVertexBuffer(float* vertices, uint32_t size);
+		SoftwareVertexBuffer(uint32_t size);
+		virtual ~SoftwareVertexBuffer() = default;
+
+		virtual void Bind() const override {}
+		virtual void Unbind() const override {}
+		virtual const BufferLayout& GetLayout() const override { return m_Layout; }
+		virtual void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
+
+		virtual void SetData(const void* data, uint32_t size) override;
+
+		const std::vector<float>& GetData() const { return m_Data; }
+	private:
+		std::vector<float> m_Data;
+		BufferLayout m_Layout;
+	};
+
+	class SoftwareIndexBuffer : public IndexBuffer
+	{
+	public:
+		SoftwareIndexBuffer(uint32_t* indices, uint32_t count);
+		virtual ~SoftwareIndexBuffer() = default;
+
+		virtual uint32_t GetCount() const { return (uint32_t)m_Indices.size(); };
+
+		virtual void Bind() const {}
+		virtual void Unbind() const {}
+
+		const std::vector<uint32_t>& GetIndices() const { return m_Indices; }
+	private:
+		std::vector<uint32_t> m_Indices;
+	};
+}
+
@@ -0,0 +1,121 @@
+#include "sepch.h"
+#include "SoftwareFrameBuffer.h"
+
+namespace SurfEngine {
+
+	static const uint32_t s_MaxFramebufferSize = 8192;
+
+	SoftwareFramebuffer::SoftwareFramebuffer(const FramebufferSpecification& spec)
+		: m_Specification(spec)
+	{
+		if (m_Specification.Samples > 1)
+			SE_CORE_WARN("Software framebuffers do not support multisampling, using 1 sample");
+
+		for (auto attachment : m_Specification.Attachments.Attachments)
+		{
+			switch (attachment.TextureFormat) {
+				case FramebufferTextureFormat::RGBA8:
+				case FramebufferTextureFormat::RED_INTEGER:
+					m_ColorAttachments.push_back(std::make_unique<SoftwareImage>());
+					m_ColorAttachmentIDs.push_back(SoftwareRasterizer::RegisterImage(m_ColorAttachments.back().get()));
+					m_Target.ColorAttachments.push_back(m_ColorAttachments.back().get());
+					m_Target.IntegerAttachments.push_back(attachment.TextureFormat == FramebufferTextureFormat::RED_INTEGER);
+					break;
+				case FramebufferTextureFormat::DEPTH24STENCIL8:
+					m_HasDepth = true;
+					break;
+				case FramebufferTextureFormat::None:
+					break;
+			}
+		}
+		m_Target.Depth = m_HasDepth ? &m_DepthAttachment : nullptr;
+
+		Invalidate();
+	}
+
+	SoftwareFramebuffer::~SoftwareFramebuffer()
+	{
+		if (SoftwareRasterizer::GetRenderTarget() == &m_Target)
+			SoftwareRasterizer::SetRenderTarget(nullptr);
+
+		for (uint32_t id : m_ColorAttachmentIDs)
+			SoftwareRasterizer::UnregisterImage(id);
+	}
+
+	void SoftwareFramebuffer::Invalidate()
+	{
+		//Pending draws were recorded against the old size
+		if (SoftwareRasterizer::GetRenderTarget() == &m_Target)
+			SoftwareRasterizer::Flush();
+
+		m_Target.Width = m_Specification.Width;
+		m_Target.Height = m_Specification.Height;
+		size_t pixelCount = (size_t)m_Specification.Width * m_Specification.Height;
+
+		for (auto& image : m_ColorAttachments) {
+			image->Width = m_Specification.Width;
+			image->Height = m_Specification.Height;
+			image->Pixels.assign(pixelCount, 0);
+		}
+
+		if (m_HasDepth)
+			m_DepthAttachment.assign(pixelCount, 1.0f);
+	}
+
+	void SoftwareFramebuffer::Bind()
+	{
+		SoftwareRasterizer::SetRenderTarget(&m_Target);
+	}
+
+	void SoftwareFramebuffer::Unbind()
+	{
+		SoftwareRasterizer::SetRenderTarget(nullptr);
+	}
+
+	void SoftwareFramebuffer::Resize(uint32_t width, uint32_t height)
+	{
+		if (width == 0 || height == 0 || width > s_MaxFramebufferSize || height > s_MaxFramebufferSize)
+		{
+			SE_CORE_WARN("Attempted to rezize framebuffer to {0}, {1}", width, height);
+			return;
+		}
+		m_Specification.Width = width;
+		m_Specification.Height = height;
+
+		Invalidate();
+	}
+
+	int SoftwareFramebuffer::ReadPixel(uint32_t attachmentIndex, int x, int y)
+	{
+		SE_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size());
+
+		const auto& pixels = GetColorAttachmentData(attachmentIndex);
+		if (x < 0 || y < 0 || x >= (int)m_Specification.Width || y >= (int)m_Specification.Height)
+			return 0;
+		return (int)pixels[(size_t)y * m_Specification.Width + x];
+	}
+
+	void SoftwareFramebuffer::ClearAttachment(uint32_t attachmentIndex, int value)
+	{
+		SE_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size());
+
+		//Keep the clear ordered with the draws recorded against this framebuffer
+		if (SoftwareRasterizer::GetRenderTarget() == &m_Target) {
+			SoftwareRasterizer::ClearAttachment(attachmentIndex, value);
+			return;
+		}
+
+		auto& pixels = m_ColorAttachments[attachmentIndex]->Pixels;
+		std::fill(pixels.begin(), pixels.end(), (uint32_t)value);
+	}
+
+	const std::vector<uint32_t>& SoftwareFramebuffer::GetColorAttachmentData(uint32_t index)
+	{
+		SE_CORE_ASSERT(index < m_ColorAttachments.size());
+
+		if (SoftwareRasterizer::GetRenderTarget() == &m_Target)
+			SoftwareRasterizer::Flush();
+		return m_ColorAttachments[index]->Pixels;
+	}
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include "SurfEngine/Renderer/FrameBuffer.h"
+#include "SurfEngine/Platform/Software/SoftwareRasterizer.h"
+
+namespace SurfEngine {
+
+	class SoftwareFramebuffer : public Framebuffer
+	{
+	public:
+		SoftwareFramebuffer(const FramebufferSpecification& spec);
+		virtual ~SoftwareFramebuffer();
+
+		void Invalidate();
+
+		virtual void Bind() override;
+		virtual void Unbind() override;
+
+		virtual void Resize(uint32_t width, uint32_t height) override;
+		virtual int ReadPixel(uint32_t attachmentIndex, int x, int y) override;
+
+		virtual void ClearAttachment(uint32_t attachmentIndex, int value) override;
+
+		virtual uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const override { SE_CORE_ASSERT(index < m_ColorAttachmentIDs.size()); return m_ColorAttachmentIDs[index]; }
+
+		virtual const FramebufferSpecification& GetSpecification() const override { return m_Specification; }
+
+		// Resolves any pending draws and returns the attachment pixels, bottom row first
+		const std::vector<uint32_t>& GetColorAttachmentData(uint32_t index = 0);
+	private:
+		FramebufferSpecification m_Specification;
+		SoftwareRenderTarget m_Target;
+
+		std::vector<Scope<SoftwareImage>> m_ColorAttachments;
+		std::vector<uint32_t> m_ColorAttachmentIDs;
+		std::vector<float> m_DepthAttachment;
+		bool m_HasDepth = false;
+	};
+
+}
+
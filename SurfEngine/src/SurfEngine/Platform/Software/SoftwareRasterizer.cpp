@@ -0,0 +1,740 @@
+#include "sepch.h"
+#include "SoftwareRasterizer.h"
+#include "SoftwareShader.h"
+#include "SoftwareBuffer.h"
+#include "SoftwareVertexArray.h"
+#include "SurfEngine/Core/JobSystem.h"
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define SE_SOFTWARE_SSE 1
+	#include <emmintrin.h>
+#else
+	#define SE_SOFTWARE_SSE 0
+#endif
+
+namespace SurfEngine {
+
+	static const int s_TileSize = 64;
+	static const uint32_t s_MaxTextureSlots = 32;
+	// Below this many recorded commands splitting tiles across the JobSystem workers costs more than it saves
+	static const size_t s_ParallelCommandThreshold = 32;
+
+	struct RasterVertex {
+		float X, Y, Z;		// Window space, Z in [0, 1]
+		float U, V;			// Texture coordinates
+		float LX, LY;		// Object space position, used by the circle program
+		uint32_t Color;		// Packed vertex color, used by the text program
+	};
+
+	struct RasterState {
+		SoftwareProgram Program = SoftwareProgram::None;
+		glm::vec4 Color = glm::vec4(1.0f);
+		const SoftwareImage* Texture = nullptr;
+		bool Blend = false;
+		SoftwareBlendMode BlendMode = SoftwareBlendMode::Alpha;
+		bool DepthTest = false;
+		bool DepthWrite = true;
+		bool Textured = false;
+		float AlphaCutoff = 0.0f;
+
+		// Grid program only
+		glm::mat4 InverseViewProjection = glm::mat4(1.0f);
+		glm::vec2 GridDerivative = glm::vec2(1.0f);
+	};
+
+	struct RasterCommand {
+		enum class Type { Triangle, Clear, ClearAttachment };
+
+		Type CommandType = Type::Triangle;
+		uint32_t State = 0;
+		RasterVertex Vertices[3];
+		int MinX = 0, MinY = 0, MaxX = -1, MaxY = -1;
+
+		glm::vec4 ClearColor = glm::vec4(0.0f);
+		uint32_t Attachment = 0;
+		uint32_t ClearValue = 0;
+	};
+
+	struct SoftwareRasterizerData {
+		std::unordered_map<uint32_t, const SoftwareImage*> Images;
+		uint32_t NextImageID = 1;
+
+		SoftwareRenderTarget* Target = nullptr;
+		const SoftwareShader* Shader = nullptr;
+		std::array<uint32_t, s_MaxTextureSlots> TextureSlots = {};
+		glm::vec4 ClearColor = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+		bool Blend = false;
+		SoftwareBlendMode BlendMode = SoftwareBlendMode::Alpha;
+		bool DepthTest = false;
+		bool DepthWrite = true;
+		bool WireFrame = false;
+
+		//Recorded work for the current target
+		std::vector<RasterState> States;
+		std::vector<RasterCommand> Commands;
+		std::vector<RasterVertex> Transformed;
+		std::vector<std::vector<uint32_t>> Bins;
+		int TilesX = 0, TilesY = 0;
+	};
+
+	static SoftwareRasterizerData* s_Data = nullptr;
+
+	namespace Utils {
+
+		static uint32_t PackColor(const glm::vec4& color) {
+			glm::vec4 c = glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f;
+			return (uint32_t)c.r | ((uint32_t)c.g << 8) | ((uint32_t)c.b << 16) | ((uint32_t)c.a << 24);
+		}
+
+		static glm::vec4 UnpackColor(uint32_t pixel) {
+			return glm::vec4(pixel & 0xFF, (pixel >> 8) & 0xFF, (pixel >> 16) & 0xFF, pixel >> 24) / 255.0f;
+		}
+
+		static float SmoothStep(float edge0, float edge1, float x) {
+			float t = glm::clamp((x - edge0) / (edge1 - edge0), 0.0f, 1.0f);
+			return t * t * (3.0f - 2.0f * t);
+		}
+
+		// Nearest filtering with repeat wrapping, same sampler state as OpenGLTexture2D
+		static glm::vec4 Sample(const SoftwareImage* image, float u, float v) {
+			if (!image || image->Pixels.empty())
+				return glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+
+			u -= floorf(u);
+			v -= floorf(v);
+			uint32_t x = std::min((uint32_t)(u * image->Width), image->Width - 1);
+			uint32_t y = std::min((uint32_t)(v * image->Height), image->Height - 1);
+			return UnpackColor(image->Pixels[(size_t)y * image->Width + x]);
+		}
+
+		// Bilinear alpha with clamped edges, same sampler state as the font atlas
+		static float SampleAlphaLinear(const SoftwareImage* image, float u, float v) {
+			if (!image || image->Pixels.empty())
+				return 0.0f;
+
+			float x = glm::clamp(u * image->Width - 0.5f, 0.0f, (float)image->Width - 1.0f);
+			float y = glm::clamp(v * image->Height - 0.5f, 0.0f, (float)image->Height - 1.0f);
+			uint32_t x0 = (uint32_t)x, y0 = (uint32_t)y;
+			uint32_t x1 = std::min(x0 + 1, image->Width - 1), y1 = std::min(y0 + 1, image->Height - 1);
+			float fx = x - x0, fy = y - y0;
+			auto alpha = [image](uint32_t px, uint32_t py) { return (float)(image->Pixels[(size_t)py * image->Width + px] >> 24); };
+			float top = alpha(x0, y0) + (alpha(x1, y0) - alpha(x0, y0)) * fx;
+			float bottom = alpha(x0, y1) + (alpha(x1, y1) - alpha(x0, y1)) * fx;
+			return (top + (bottom - top) * fy) / 255.0f;
+		}
+
+		static float Edge(const RasterVertex& a, const RasterVertex& b, float x, float y) {
+			return (b.X - a.X) * (y - a.Y) - (b.Y - a.Y) * (x - a.X);
+		}
+
+		// Top-left fill rule for counter clockwise triangles so shared edges are only drawn once
+		static bool IsTopLeft(const RasterVertex& a, const RasterVertex& b) {
+			float dy = b.Y - a.Y;
+			return dy < 0.0f || (dy == 0.0f && b.X < a.X);
+		}
+	}
+
+	static bool ShadeFragment(const RasterState& state, const RasterCommand& command, float l0, float l1, float l2, int x, int y, glm::vec4& color) {
+		const RasterVertex& v0 = command.Vertices[0];
+		const RasterVertex& v1 = command.Vertices[1];
+		const RasterVertex& v2 = command.Vertices[2];
+
+		switch (state.Program) {
+			case SoftwareProgram::None:
+				return false;
+			case SoftwareProgram::Color:
+				color = state.Color;
+				return true;
+			case SoftwareProgram::Sprite: {
+				float u = l0 * v0.U + l1 * v1.U + l2 * v2.U;
+				float v = l0 * v0.V + l1 * v1.V + l2 * v2.V;
+				color = Utils::Sample(state.Texture, u, v) * state.Color;
+				return color.a >= state.AlphaCutoff;
+			}
+			case SoftwareProgram::Gizmo: {
+				float u = l0 * v0.U + l1 * v1.U + l2 * v2.U;
+				float v = l0 * v0.V + l1 * v1.V + l2 * v2.V;
+				color = Utils::Sample(state.Texture, u, v);
+				if (color.a > 0.0f)
+					color = state.Color;
+				return true;
+			}
+			case SoftwareProgram::Circle: {
+				glm::vec2 local = glm::vec2(l0 * v0.LX + l1 * v1.LX + l2 * v2.LX, l0 * v0.LY + l1 * v1.LY + l2 * v2.LY);
+				float distance = 1.0f - glm::length(local * 2.0f);
+				float circle = Utils::SmoothStep(0.0f, 0.005f, distance);
+				circle *= Utils::SmoothStep(0.01f + 0.005f, 0.01f, distance);
+				if (circle == 0.0f)
+					return false;
+				color = state.Color;
+				color.a *= circle;
+				return true;
+			}
+			case SoftwareProgram::Particle: {
+				if (state.Textured) {
+					float u = l0 * v0.U + l1 * v1.U + l2 * v2.U;
+					float v = l0 * v0.V + l1 * v1.V + l2 * v2.V;
+					color = Utils::Sample(state.Texture, u, v) * state.Color;
+					return true;
+				}
+				glm::vec2 local = glm::vec2(l0 * v0.LX + l1 * v1.LX + l2 * v2.LX, l0 * v0.LY + l1 * v1.LY + l2 * v2.LY);
+				float falloff = 1.0f - Utils::SmoothStep(0.3f, 0.5f, glm::length(local));
+				if (falloff <= 0.0f)
+					return false;
+				color = state.Color;
+				color.a *= falloff;
+				return true;
+			}
+			case SoftwareProgram::Text: {
+				//Fixed edge width in place of fwidth(), see text.glsl
+				float u = l0 * v0.U + l1 * v1.U + l2 * v2.U;
+				float v = l0 * v0.V + l1 * v1.V + l2 * v2.V;
+				float alpha = Utils::SmoothStep(0.45f, 0.55f, Utils::SampleAlphaLinear(state.Texture, u, v));
+				if (alpha <= 0.0f)
+					return false;
+				color = Utils::UnpackColor(v0.Color);
+				color.a *= alpha;
+				return true;
+			}
+			case SoftwareProgram::Grid: {
+				const SoftwareRenderTarget& target = *s_Data->Target;
+				glm::vec4 ndc = glm::vec4((x + 0.5f) / target.Width * 2.0f - 1.0f, (y + 0.5f) / target.Height * 2.0f - 1.0f, 0.0f, 1.0f);
+				glm::vec4 world = state.InverseViewProjection * ndc;
+				glm::vec2 coord = glm::vec2(world) / world.w;
+
+				glm::vec2 grid = glm::abs(glm::fract(coord - 0.5f) - 0.5f) / state.GridDerivative;
+				float line = std::min(grid.x, grid.y) / 4.0f;
+				float minimumy = std::min(state.GridDerivative.y, 1.0f);
+				float minimumx = std::min(state.GridDerivative.x, 1.0f);
+				color = glm::vec4(0.4f, 0.4f, 0.4f, 0.8f - std::min(line, 1.0f));
+				if (coord.x > -0.5f * minimumx && coord.x < 0.5f * minimumx)
+					color = glm::vec4(0.0f, 1.0f, 0.0f, 1.0f);
+				if (coord.y > -0.5f * minimumy && coord.y < 0.5f * minimumy)
+					color = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	static void ShadePixel(const RasterState& state, const RasterCommand& command, int x, int y, float l0, float l1, float l2) {
+		SoftwareRenderTarget& target = *s_Data->Target;
+		const RasterVertex* v = command.Vertices;
+
+		//Stand in for near/far clipping
+		float z = l0 * v[0].Z + l1 * v[1].Z + l2 * v[2].Z;
+		if (z < 0.0f || z > 1.0f)
+			return;
+
+		size_t index = (size_t)y * target.Width + x;
+		bool depthTest = state.DepthTest && target.Depth;
+		if (depthTest && !(z < (*target.Depth)[index]))
+			return;
+
+		glm::vec4 color;
+		if (!ShadeFragment(state, command, l0, l1, l2, x, y, color))
+			return;
+
+		if (depthTest && state.DepthWrite)
+			(*target.Depth)[index] = z;
+
+		//Engine shaders only write to location 0
+		if (target.ColorAttachments.empty() || target.IntegerAttachments[0])
+			return;
+
+		uint32_t& pixel = target.ColorAttachments[0]->Pixels[index];
+		color = glm::clamp(color, 0.0f, 1.0f);
+		if (state.Blend) {
+			glm::vec4 dst = Utils::UnpackColor(pixel);
+			float alpha = color.a;
+			switch (state.BlendMode) {
+			case SoftwareBlendMode::Alpha:
+				color = color * alpha + dst * (1.0f - alpha);
+				break;
+			case SoftwareBlendMode::PremultipliedAlpha:
+				color = color + dst * (1.0f - alpha);
+				break;
+			case SoftwareBlendMode::AlphaToPremultiplied:
+				color = glm::vec4(glm::vec3(color) * alpha, alpha) + dst * (1.0f - alpha);
+				break;
+			}
+		}
+		pixel = Utils::PackColor(color);
+	}
+
+	static void RasterizeTriangle(const RasterCommand& command, int tileMinX, int tileMinY, int tileMaxX, int tileMaxY) {
+		int minX = std::max(command.MinX, tileMinX);
+		int minY = std::max(command.MinY, tileMinY);
+		int maxX = std::min(command.MaxX, tileMaxX);
+		int maxY = std::min(command.MaxY, tileMaxY);
+		if (minX > maxX || minY > maxY)
+			return;
+
+		const RasterState& state = s_Data->States[command.State];
+		const RasterVertex& v0 = command.Vertices[0];
+		const RasterVertex& v1 = command.Vertices[1];
+		const RasterVertex& v2 = command.Vertices[2];
+
+		float invArea = 1.0f / Utils::Edge(v0, v1, v2.X, v2.Y);
+
+		//Edge function steps, w0 weights v0 and so on
+		float stepX0 = v1.Y - v2.Y, stepY0 = v2.X - v1.X;
+		float stepX1 = v2.Y - v0.Y, stepY1 = v0.X - v2.X;
+		float stepX2 = v0.Y - v1.Y, stepY2 = v1.X - v0.X;
+		bool topLeft0 = Utils::IsTopLeft(v1, v2);
+		bool topLeft1 = Utils::IsTopLeft(v2, v0);
+		bool topLeft2 = Utils::IsTopLeft(v0, v1);
+
+		float startX = minX + 0.5f, startY = minY + 0.5f;
+		float row0 = Utils::Edge(v1, v2, startX, startY);
+		float row1 = Utils::Edge(v2, v0, startX, startY);
+		float row2 = Utils::Edge(v0, v1, startX, startY);
+
+#if SE_SOFTWARE_SSE
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 lanes = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+		const __m128 laneStep0 = _mm_mul_ps(lanes, _mm_set1_ps(stepX0));
+		const __m128 laneStep1 = _mm_mul_ps(lanes, _mm_set1_ps(stepX1));
+		const __m128 laneStep2 = _mm_mul_ps(lanes, _mm_set1_ps(stepX2));
+		const __m128 tlMask0 = _mm_castsi128_ps(_mm_set1_epi32(topLeft0 ? -1 : 0));
+		const __m128 tlMask1 = _mm_castsi128_ps(_mm_set1_epi32(topLeft1 ? -1 : 0));
+		const __m128 tlMask2 = _mm_castsi128_ps(_mm_set1_epi32(topLeft2 ? -1 : 0));
+
+		for (int y = minY; y <= maxY; y++) {
+			float w0 = row0, w1 = row1, w2 = row2;
+			for (int x = minX; x <= maxX; x += 4) {
+				__m128 e0 = _mm_add_ps(_mm_set1_ps(w0), laneStep0);
+				__m128 e1 = _mm_add_ps(_mm_set1_ps(w1), laneStep1);
+				__m128 e2 = _mm_add_ps(_mm_set1_ps(w2), laneStep2);
+
+				__m128 in0 = _mm_or_ps(_mm_cmpgt_ps(e0, zero), _mm_and_ps(_mm_cmpeq_ps(e0, zero), tlMask0));
+				__m128 in1 = _mm_or_ps(_mm_cmpgt_ps(e1, zero), _mm_and_ps(_mm_cmpeq_ps(e1, zero), tlMask1));
+				__m128 in2 = _mm_or_ps(_mm_cmpgt_ps(e2, zero), _mm_and_ps(_mm_cmpeq_ps(e2, zero), tlMask2));
+				int coverage = _mm_movemask_ps(_mm_and_ps(_mm_and_ps(in0, in1), in2));
+
+				if (coverage) {
+					alignas(16) float l0[4], l1[4], l2[4];
+					_mm_store_ps(l0, e0);
+					_mm_store_ps(l1, e1);
+					_mm_store_ps(l2, e2);
+					for (int lane = 0; lane < 4 && x + lane <= maxX; lane++) {
+						if (coverage & (1 << lane))
+							ShadePixel(state, command, x + lane, y, l0[lane] * invArea, l1[lane] * invArea, l2[lane] * invArea);
+					}
+				}
+
+				w0 += stepX0 * 4.0f;
+				w1 += stepX1 * 4.0f;
+				w2 += stepX2 * 4.0f;
+			}
+			row0 += stepY0;
+			row1 += stepY1;
+			row2 += stepY2;
+		}
+#else
+		for (int y = minY; y <= maxY; y++) {
+			float w0 = row0, w1 = row1, w2 = row2;
+			for (int x = minX; x <= maxX; x++) {
+				bool inside = (w0 > 0.0f || (w0 == 0.0f && topLeft0))
+					&& (w1 > 0.0f || (w1 == 0.0f && topLeft1))
+					&& (w2 > 0.0f || (w2 == 0.0f && topLeft2));
+				if (inside)
+					ShadePixel(state, command, x, y, w0 * invArea, w1 * invArea, w2 * invArea);
+
+				w0 += stepX0;
+				w1 += stepX1;
+				w2 += stepX2;
+			}
+			row0 += stepY0;
+			row1 += stepY1;
+			row2 += stepY2;
+		}
+#endif
+	}
+
+	static void RasterizeTile(uint32_t tile) {
+		SoftwareRenderTarget& target = *s_Data->Target;
+		int minX = (int)(tile % s_Data->TilesX) * s_TileSize;
+		int minY = (int)(tile / s_Data->TilesX) * s_TileSize;
+		int maxX = std::min(minX + s_TileSize, (int)target.Width) - 1;
+		int maxY = std::min(minY + s_TileSize, (int)target.Height) - 1;
+
+		for (uint32_t index : s_Data->Bins[tile]) {
+			const RasterCommand& command = s_Data->Commands[index];
+			switch (command.CommandType) {
+				case RasterCommand::Type::Triangle:
+					RasterizeTriangle(command, minX, minY, maxX, maxY);
+					break;
+				case RasterCommand::Type::Clear: {
+					uint32_t packed = Utils::PackColor(command.ClearColor);
+					for (int y = minY; y <= maxY; y++) {
+						size_t row = (size_t)y * target.Width;
+						for (size_t i = 0; i < target.ColorAttachments.size(); i++) {
+							if (target.IntegerAttachments[i])
+								continue;
+							uint32_t* pixels = target.ColorAttachments[i]->Pixels.data() + row;
+							std::fill(pixels + minX, pixels + maxX + 1, packed);
+						}
+						if (target.Depth)
+							std::fill(target.Depth->begin() + row + minX, target.Depth->begin() + row + maxX + 1, 1.0f);
+					}
+					break;
+				}
+				case RasterCommand::Type::ClearAttachment: {
+					if (command.Attachment >= target.ColorAttachments.size())
+						break;
+					for (int y = minY; y <= maxY; y++) {
+						uint32_t* pixels = target.ColorAttachments[command.Attachment]->Pixels.data() + (size_t)y * target.Width;
+						std::fill(pixels + minX, pixels + maxX + 1, command.ClearValue);
+					}
+					break;
+				}
+			}
+		}
+	}
+
+	void SoftwareRasterizer::Init() {
+		if (s_Data)
+			return;
+		s_Data = new SoftwareRasterizerData();
+	}
+
+	void SoftwareRasterizer::Shutdown() {
+		if (!s_Data)
+			return;
+
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	uint32_t SoftwareRasterizer::RegisterImage(const SoftwareImage* image) {
+		uint32_t id = s_Data->NextImageID++;
+		s_Data->Images[id] = image;
+		return id;
+	}
+
+	void SoftwareRasterizer::UnregisterImage(uint32_t id) {
+		if (!s_Data)
+			return;
+
+		//Recorded draws may still sample this image
+		if (!s_Data->Commands.empty())
+			Flush();
+		s_Data->Images.erase(id);
+	}
+
+	const SoftwareImage* SoftwareRasterizer::GetImage(uint32_t id) {
+		auto it = s_Data->Images.find(id);
+		return it != s_Data->Images.end() ? it->second : nullptr;
+	}
+
+	void SoftwareRasterizer::SetRenderTarget(SoftwareRenderTarget* target) {
+		if (s_Data->Target != target)
+			Flush();
+		s_Data->Target = target;
+	}
+
+	SoftwareRenderTarget* SoftwareRasterizer::GetRenderTarget() {
+		return s_Data ? s_Data->Target : nullptr;
+	}
+
+	void SoftwareRasterizer::BindShader(const SoftwareShader* shader) {
+		s_Data->Shader = shader;
+	}
+
+	void SoftwareRasterizer::BindTexture(uint32_t slot, uint32_t id) {
+		if (slot < s_MaxTextureSlots)
+			s_Data->TextureSlots[slot] = id;
+	}
+
+	void SoftwareRasterizer::SetClearColor(const glm::vec4& color) {
+		s_Data->ClearColor = color;
+	}
+
+	void SoftwareRasterizer::SetBlending(bool enabled) {
+		s_Data->Blend = enabled;
+	}
+
+	void SoftwareRasterizer::SetBlendMode(SoftwareBlendMode mode) {
+		s_Data->BlendMode = mode;
+	}
+
+	void SoftwareRasterizer::SetDepthTest(bool enabled) {
+		s_Data->DepthTest = enabled;
+	}
+
+	void SoftwareRasterizer::SetDepthWrite(bool enabled) {
+		s_Data->DepthWrite = enabled;
+	}
+
+	void SoftwareRasterizer::SetWireFrame(bool enabled) {
+		s_Data->WireFrame = enabled;
+	}
+
+	void SoftwareRasterizer::Clear() {
+		if (!s_Data->Target)
+			return;
+
+		RasterCommand command;
+		command.CommandType = RasterCommand::Type::Clear;
+		command.ClearColor = s_Data->ClearColor;
+		s_Data->Commands.push_back(command);
+	}
+
+	void SoftwareRasterizer::ClearAttachment(uint32_t attachmentIndex, int value) {
+		if (!s_Data->Target)
+			return;
+
+		RasterCommand command;
+		command.CommandType = RasterCommand::Type::ClearAttachment;
+		command.Attachment = attachmentIndex;
+		command.ClearValue = (uint32_t)value;
+		s_Data->Commands.push_back(command);
+	}
+
+	static bool PushState() {
+		if (!s_Data->Target || !s_Data->Shader)
+			return false;
+
+		SoftwareDrawState draw = s_Data->Shader->GetDrawState();
+		if (draw.Program == SoftwareProgram::None)
+			return false;
+
+		RasterState state;
+		state.Program = draw.Program;
+		state.Color = draw.Color;
+		state.Blend = s_Data->Blend;
+		state.BlendMode = s_Data->BlendMode;
+		state.Textured = draw.Textured;
+		state.DepthTest = s_Data->DepthTest;
+		state.DepthWrite = s_Data->DepthWrite;
+		state.AlphaCutoff = draw.Program == SoftwareProgram::Sprite ? draw.AlphaCutoff : 0.0f;
+		if (draw.TextureSlot >= 0 && draw.TextureSlot < (int)s_MaxTextureSlots)
+			state.Texture = SoftwareRasterizer::GetImage(s_Data->TextureSlots[draw.TextureSlot]);
+
+		if (draw.Program == SoftwareProgram::Grid) {
+			const SoftwareRenderTarget& target = *s_Data->Target;
+			state.InverseViewProjection = glm::inverse(draw.ViewProjection);
+			//Equivalent of fwidth() for an affine projection
+			glm::vec2 dx = glm::vec2(state.InverseViewProjection[0]) * (2.0f / target.Width);
+			glm::vec2 dy = glm::vec2(state.InverseViewProjection[1]) * (2.0f / target.Height);
+			state.GridDerivative = glm::max(glm::abs(dx) + glm::abs(dy), glm::vec2(1e-6f));
+		}
+
+		s_Data->States.push_back(state);
+		return true;
+	}
+
+	static void TransformVertices(const SoftwareVertexArray& vertexArray, uint32_t instance = 0) {
+		const SoftwareRenderTarget& target = *s_Data->Target;
+		SoftwareDrawState draw = s_Data->Shader->GetDrawState();
+		glm::mat4 mvp = draw.Program == SoftwareProgram::Grid ? glm::mat4(1.0f) : draw.ViewProjection * draw.Transform;
+
+		//Particle quads are placed by their instance center and size
+		float instanceData[3] = { 0.0f, 0.0f, 1.0f };
+		if (draw.Program == SoftwareProgram::Particle) {
+			vertexArray.FetchAttribute(2, 0, instanceData, instance);
+			mvp = draw.ViewProjection;
+		}
+
+		//Sprite sheet frame, same as sprite.glsl
+		float frames = std::max(draw.FrameCount, 1.0f);
+		float frame = 0.0f;
+		if (draw.Program == SoftwareProgram::Sprite) {
+			frame = draw.Animation.z + floorf(std::max(draw.Time - draw.Animation.x, 0.0f) * draw.Animation.y);
+			if (draw.Animation.w > 0.5f)
+				frame -= frames * floorf(frame / frames);
+			else if (frame >= frames)
+				frame = 0.0f;
+		}
+
+		uint32_t count = vertexArray.GetVertexCount();
+		s_Data->Transformed.resize(count);
+		for (uint32_t i = 0; i < count; i++) {
+			float position[3] = { 0.0f, 0.0f, 0.0f };
+			float texCoord[2] = { 0.0f, 0.0f };
+			float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+			vertexArray.FetchAttribute(0, i, position);
+			vertexArray.FetchAttribute(1, i, texCoord);
+			if (draw.Program == SoftwareProgram::Text)
+				vertexArray.FetchAttribute(2, i, color);
+
+			glm::vec3 placed = glm::vec3(position[0], position[1], position[2]);
+			if (draw.Program == SoftwareProgram::Particle)
+				placed = glm::vec3(instanceData[0] + position[0] * instanceData[2], instanceData[1] + position[1] * instanceData[2], draw.Depth);
+			else if (draw.Program == SoftwareProgram::Color)
+				placed.z += draw.Depth;
+			else if (draw.Program == SoftwareProgram::Sprite) {
+				placed.z += draw.Depth;
+				texCoord[0] = (texCoord[0] + frame) / frames;
+			}
+
+			//Every engine camera is orthographic so the divide is only here for completeness
+			glm::vec4 clip = mvp * glm::vec4(placed, 1.0f);
+			if (clip.w != 0.0f)
+				clip /= clip.w;
+
+			RasterVertex& vertex = s_Data->Transformed[i];
+			vertex.X = (clip.x * 0.5f + 0.5f) * target.Width;
+			vertex.Y = (clip.y * 0.5f + 0.5f) * target.Height;
+			vertex.Z = clip.z * 0.5f + 0.5f;
+			vertex.U = (texCoord[0] - 0.5f) * draw.Scale.x + (0.5f * draw.Scale.x) - draw.Offset.x;
+			vertex.V = (texCoord[1] - 0.5f) * draw.Scale.y + (0.5f * draw.Scale.y) - draw.Offset.y;
+			vertex.LX = position[0];
+			vertex.LY = position[1];
+			vertex.Color = Utils::PackColor(glm::vec4(color[0], color[1], color[2], color[3]));
+		}
+	}
+
+	static void PushTriangle(RasterVertex v0, RasterVertex v1, RasterVertex v2) {
+		const SoftwareRenderTarget& target = *s_Data->Target;
+
+		float area = Utils::Edge(v0, v1, v2.X, v2.Y);
+		if (fabsf(area) < 1e-8f)
+			return;
+		//Culling is disabled, wind everything counter clockwise
+		if (area < 0.0f)
+			std::swap(v1, v2);
+
+		RasterCommand command;
+		command.State = (uint32_t)s_Data->States.size() - 1;
+		command.MinX = std::max((int)floorf(std::min({ v0.X, v1.X, v2.X })), 0);
+		command.MinY = std::max((int)floorf(std::min({ v0.Y, v1.Y, v2.Y })), 0);
+		command.MaxX = std::min((int)ceilf(std::max({ v0.X, v1.X, v2.X })), (int)target.Width - 1);
+		command.MaxY = std::min((int)ceilf(std::max({ v0.Y, v1.Y, v2.Y })), (int)target.Height - 1);
+		if (command.MinX > command.MaxX || command.MinY > command.MaxY)
+			return;
+
+		command.Vertices[0] = v0;
+		command.Vertices[1] = v1;
+		command.Vertices[2] = v2;
+		s_Data->Commands.push_back(command);
+	}
+
+	// Lines are expanded into two pixel wide quads, matching glLineWidth(2.0f)
+	static void PushLine(const RasterVertex& a, const RasterVertex& b) {
+		float dx = b.X - a.X, dy = b.Y - a.Y;
+		float length = sqrtf(dx * dx + dy * dy);
+		if (length < 1e-6f)
+			return;
+
+		float nx = -dy / length, ny = dx / length;
+		RasterVertex corners[4] = { a, a, b, b };
+		corners[0].X += nx; corners[0].Y += ny;
+		corners[1].X -= nx; corners[1].Y -= ny;
+		corners[2].X -= nx; corners[2].Y -= ny;
+		corners[3].X += nx; corners[3].Y += ny;
+
+		PushTriangle(corners[0], corners[1], corners[2]);
+		PushTriangle(corners[2], corners[3], corners[0]);
+	}
+
+	static void PushIndexed(const SoftwareIndexBuffer& indexBuffer, uint32_t indexCount = 0) {
+		const auto& vertices = s_Data->Transformed;
+		const auto& indices = indexBuffer.GetIndices();
+		const size_t count = indexCount ? std::min((size_t)indexCount, indices.size()) : indices.size();
+		for (size_t i = 0; i + 2 < count; i += 3) {
+			if (indices[i] >= vertices.size() || indices[i + 1] >= vertices.size() || indices[i + 2] >= vertices.size())
+				continue;
+
+			const RasterVertex& v0 = vertices[indices[i]];
+			const RasterVertex& v1 = vertices[indices[i + 1]];
+			const RasterVertex& v2 = vertices[indices[i + 2]];
+			if (s_Data->WireFrame) {
+				PushLine(v0, v1);
+				PushLine(v1, v2);
+				PushLine(v2, v0);
+			}
+			else {
+				PushTriangle(v0, v1, v2);
+			}
+		}
+	}
+
+	void SoftwareRasterizer::DrawIndexed(const SoftwareVertexArray& vertexArray, uint32_t indexCount) {
+		const auto& indexBuffer = vertexArray.GetIndexBuffer();
+		if (!indexBuffer || !PushState())
+			return;
+
+		TransformVertices(vertexArray);
+		PushIndexed(static_cast<const SoftwareIndexBuffer&>(*indexBuffer), indexCount);
+	}
+
+	void SoftwareRasterizer::DrawIndexedInstanced(const SoftwareVertexArray& vertexArray, uint32_t instanceCount) {
+		const auto& indexBuffer = vertexArray.GetIndexBuffer();
+		if (!indexBuffer)
+			return;
+
+		for (uint32_t instance = 0; instance < instanceCount; instance++) {
+			//Each instance gets its own state to carry its color
+			if (!PushState())
+				return;
+			float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+			vertexArray.FetchAttribute(3, 0, color, instance);
+			s_Data->States.back().Color *= glm::vec4(color[0], color[1], color[2], color[3]);
+
+			TransformVertices(vertexArray, instance);
+			PushIndexed(static_cast<const SoftwareIndexBuffer&>(*indexBuffer));
+		}
+	}
+
+	void SoftwareRasterizer::DrawLine(const SoftwareVertexArray& vertexArray) {
+		if (!PushState())
+			return;
+
+		TransformVertices(vertexArray);
+		if (s_Data->Transformed.size() >= 2)
+			PushLine(s_Data->Transformed[0], s_Data->Transformed[1]);
+	}
+
+	void SoftwareRasterizer::Flush() {
+		if (!s_Data || s_Data->Commands.empty())
+			return;
+
+		SoftwareRenderTarget* target = s_Data->Target;
+		if (!target || target->Width == 0 || target->Height == 0) {
+			s_Data->Commands.clear();
+			s_Data->States.clear();
+			return;
+		}
+
+		//Bin every command into the screen tiles it touches, keeping submission order per tile
+		s_Data->TilesX = ((int)target->Width + s_TileSize - 1) / s_TileSize;
+		s_Data->TilesY = ((int)target->Height + s_TileSize - 1) / s_TileSize;
+		uint32_t tileCount = (uint32_t)(s_Data->TilesX * s_Data->TilesY);
+		if (s_Data->Bins.size() < tileCount)
+			s_Data->Bins.resize(tileCount);
+		for (uint32_t i = 0; i < tileCount; i++)
+			s_Data->Bins[i].clear();
+
+		for (uint32_t i = 0; i < (uint32_t)s_Data->Commands.size(); i++) {
+			const RasterCommand& command = s_Data->Commands[i];
+			if (command.CommandType != RasterCommand::Type::Triangle) {
+				for (uint32_t tile = 0; tile < tileCount; tile++)
+					s_Data->Bins[tile].push_back(i);
+				continue;
+			}
+
+			int minTileX = command.MinX / s_TileSize, maxTileX = command.MaxX / s_TileSize;
+			int minTileY = command.MinY / s_TileSize, maxTileY = command.MaxY / s_TileSize;
+			for (int ty = minTileY; ty <= maxTileY; ty++)
+				for (int tx = minTileX; tx <= maxTileX; tx++)
+					s_Data->Bins[ty * s_Data->TilesX + tx].push_back(i);
+		}
+
+		//Tiles never share pixels so they can be shaded in any order on any thread
+		if (tileCount == 1 || s_Data->Commands.size() < s_ParallelCommandThreshold) {
+			for (uint32_t tile = 0; tile < tileCount; tile++)
+				RasterizeTile(tile);
+		}
+		else {
+			JobSystem::ParallelFor(tileCount, 1, [](uint32_t begin, uint32_t end) {
+				for (uint32_t tile = begin; tile < end; tile++)
+					RasterizeTile(tile);
+			});
+		}
+
+		s_Data->Commands.clear();
+		s_Data->States.clear();
+	}
+}
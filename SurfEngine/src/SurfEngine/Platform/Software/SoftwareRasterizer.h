@@ -0,0 +1,91 @@
+#pragma once
+#include <glm/glm.hpp>
+
+namespace SurfEngine {
+
+	// CPU side image used for textures and framebuffer attachments
+	// RGBA8 pixels are packed as R | G << 8 | B << 16 | A << 24, integer attachments store the raw value
+	// Row 0 is the bottom row, matching the OpenGL memory layout
+	struct SoftwareImage {
+		uint32_t Width = 0, Height = 0;
+		std::vector<uint32_t> Pixels;
+	};
+
+	struct SoftwareRenderTarget {
+		uint32_t Width = 0, Height = 0;
+		std::vector<SoftwareImage*> ColorAttachments;
+		std::vector<bool> IntegerAttachments;
+		std::vector<float>* Depth = nullptr;
+	};
+
+	// Fixed function stand ins for the engine shaders
+	enum class SoftwareProgram {
+		None = 0, Color, Sprite, Circle, Gizmo, Grid, Particle, Text
+	};
+
+	// Mirrors RendererAPI::BlendMode
+	enum class SoftwareBlendMode {
+		Alpha = 0, PremultipliedAlpha, AlphaToPremultiplied
+	};
+
+	struct SoftwareDrawState {
+		SoftwareProgram Program = SoftwareProgram::None;
+		glm::mat4 ViewProjection = glm::mat4(1.0f);
+		glm::mat4 Transform = glm::mat4(1.0f);
+		glm::vec4 Color = glm::vec4(1.0f);
+		glm::vec2 Scale = glm::vec2(1.0f);
+		glm::vec2 Offset = glm::vec2(0.0f);
+		int TextureSlot = 0;
+
+		// Sprite, color and particle programs
+		float Depth = 0.0f;
+
+		// Particle program only
+		bool Textured = false;
+
+		// Sprite program only, see sprite.glsl
+		float Time = 0.0f;
+		glm::vec4 Animation = glm::vec4(0.0f);
+		float FrameCount = 1.0f;
+		float AlphaCutoff = 0.0f;
+	};
+
+	class SoftwareShader;
+	class SoftwareVertexArray;
+
+	// Deferred tile based rasterizer
+	// Draws are transformed and recorded as they are submitted, then binned into screen tiles and
+	// shaded in parallel when the render target changes or its pixels are read back
+	class SoftwareRasterizer {
+	public:
+		static void Init();
+		static void Shutdown();
+
+		static uint32_t RegisterImage(const SoftwareImage* image);
+		static void UnregisterImage(uint32_t id);
+		static const SoftwareImage* GetImage(uint32_t id);
+
+		static void SetRenderTarget(SoftwareRenderTarget* target);
+		static SoftwareRenderTarget* GetRenderTarget();
+
+		static void BindShader(const SoftwareShader* shader);
+		static void BindTexture(uint32_t slot, uint32_t id);
+
+		static void SetClearColor(const glm::vec4& color);
+		static void SetBlending(bool enabled);
+		static void SetBlendMode(SoftwareBlendMode mode);
+		static void SetDepthTest(bool enabled);
+		static void SetDepthWrite(bool enabled);
+		static void SetWireFrame(bool enabled);
+
+		static void Clear();
+		static void ClearAttachment(uint32_t attachmentIndex, int value);
+		static void DrawIndexed(const SoftwareVertexArray& vertexArray, uint32_t indexCount = 0);
+		// Instanced draws only support the particle program, attribute 2 is center and size and 3 is color
+		static void DrawIndexedInstanced(const SoftwareVertexArray& vertexArray, uint32_t instanceCount);
+		static void DrawLine(const SoftwareVertexArray& vertexArray);
+
+		// Shades everything recorded for the current render target
+		static void Flush();
+	};
+}
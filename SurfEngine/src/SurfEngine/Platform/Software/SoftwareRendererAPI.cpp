@@ -0,0 +1,82 @@
+#include "sepch.h"
+#include "SoftwareRendererAPI.h"
+#include "SoftwareRasterizer.h"
+#include "SoftwareVertexArray.h"
+
+namespace SurfEngine {
+
+	SoftwareRendererAPI::SoftwareRendererAPI() {
+		SoftwareRasterizer::Init();
+	}
+
+	SoftwareRendererAPI::~SoftwareRendererAPI() {
+		SoftwareRasterizer::Shutdown();
+	}
+
+	void SoftwareRendererAPI::SetClearColor(const glm::vec4 color) {
+		SoftwareRasterizer::SetClearColor(color);
+	}
+
+	void SoftwareRendererAPI::Clear() {
+		SoftwareRasterizer::Clear();
+	}
+
+	void SoftwareRendererAPI::EnableTextures() {
+		//Texturing is always on
+	}
+
+	void SoftwareRendererAPI::EnableMSAA() {
+		//Not supported, draws are single sampled
+	}
+
+	void SoftwareRendererAPI::EnableDepth() {
+		SoftwareRasterizer::SetDepthTest(true);
+	}
+
+	void SoftwareRendererAPI::SetDepthMode(RendererAPI::DepthMode mode) {
+		SoftwareRasterizer::SetDepthTest(mode != RendererAPI::DepthMode::Off);
+		SoftwareRasterizer::SetDepthWrite(mode != RendererAPI::DepthMode::Test);
+	}
+
+	void SoftwareRendererAPI::EnableBlending() {
+		SoftwareRasterizer::SetBlending(true);
+	}
+
+	void SoftwareRendererAPI::SetBlendMode(RendererAPI::BlendMode mode) {
+		SoftwareRasterizer::SetBlendMode((SoftwareBlendMode)mode);
+	}
+
+	void SoftwareRendererAPI::BindTextureId(int slot, uint32_t id) {
+		SoftwareRasterizer::BindTexture(slot, id);
+	}
+
+	void SoftwareRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount) {
+		SoftwareRasterizer::DrawIndexed(static_cast<const SoftwareVertexArray&>(*vertexArray), indexCount);
+	}
+
+	void SoftwareRendererAPI::DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t instanceCount) {
+		SoftwareRasterizer::DrawIndexedInstanced(static_cast<const SoftwareVertexArray&>(*vertexArray), instanceCount);
+	}
+
+	void SoftwareRendererAPI::DrawLine(const Ref<VertexArray>& vertexArray) {
+		SoftwareRasterizer::DrawLine(static_cast<const SoftwareVertexArray&>(*vertexArray));
+	}
+
+	void SoftwareRendererAPI::SetWireFrameMode(RendererAPI::WireFrameMode mode) {
+		SoftwareRasterizer::SetWireFrame(mode == RendererAPI::WireFrameMode::On);
+	}
+
+	void SoftwareRendererAPI::BeginGPUTimer() {
+		m_TimerStart = std::chrono::steady_clock::now();
+	}
+
+	void SoftwareRendererAPI::EndGPUTimer() {
+		//Shade whatever is still recorded so it counts towards this frame
+		SoftwareRasterizer::Flush();
+		m_GPUTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - m_TimerStart).count();
+	}
+
+	float SoftwareRendererAPI::GetGPUTime() {
+		return m_GPUTime;
+	}
+}
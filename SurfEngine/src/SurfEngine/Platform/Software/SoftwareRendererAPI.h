@@ -0,0 +1,36 @@
+#pragma once
+#include "SurfEngine/Renderer/RendererAPI.h"
+#include <chrono>
+
+
+namespace SurfEngine {
+	// CPU renderer for machines without a usable GPU, headless servers and thumbnail generation
+	class SoftwareRendererAPI : public RendererAPI
+	{
+	public:
+		SoftwareRendererAPI();
+		virtual ~SoftwareRendererAPI();
+
+		virtual void SetClearColor(const glm::vec4 color) override;
+		virtual void Clear() override;
+		virtual void EnableTextures() override;
+		virtual void EnableMSAA() override;
+		virtual void EnableDepth() override;
+		virtual void BindTextureId(int slot, uint32_t id) override;
+		virtual void EnableBlending() override;
+		virtual void SetDepthMode(DepthMode mode) override;
+		virtual void SetBlendMode(RendererAPI::BlendMode mode) override;
+		virtual void SetWireFrameMode(RendererAPI::WireFrameMode mode) override;
+		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0) override;
+		virtual void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t instanceCount) override;
+		virtual void DrawLine(const Ref<VertexArray>& vertexArray) override;
+		// Rasterization runs on the calling thread, so the timer measures wall time and is ready right away
+		virtual void BeginGPUTimer() override;
+		virtual void EndGPUTimer() override;
+		virtual float GetGPUTime() override;
+	private:
+		std::chrono::steady_clock::time_point m_TimerStart;
+		float m_GPUTime = -1.0f;
+	};
+}
+
@@ -0,0 +1,102 @@
+#include "sepch.h"
+#include "SoftwareShader.h"
+
+namespace SurfEngine {
+
+	static SoftwareProgram ProgramFromName(const std::string& name) {
+		if (name == "color") return SoftwareProgram::Color;
+		if (name == "sprite" || name == "reflection") return SoftwareProgram::Sprite;
+		if (name == "circle") return SoftwareProgram::Circle;
+		if (name == "gizmo") return SoftwareProgram::Gizmo;
+		if (name == "background_grid_2d") return SoftwareProgram::Grid;
+		if (name == "particle") return SoftwareProgram::Particle;
+		if (name == "text") return SoftwareProgram::Text;
+		return SoftwareProgram::None;
+	}
+
+	SoftwareShader::SoftwareShader(const std::string& filepath) {
+		//Extract Name from filepath
+		auto lastSlash = filepath.find_last_of("/\\");
+		lastSlash = lastSlash == std::string::npos ? 0 : lastSlash + 1;
+		auto lastDot = filepath.rfind(".");
+		auto count = lastDot == std::string::npos || lastDot < lastSlash ? filepath.size() - lastSlash : lastDot - lastSlash;
+		m_Name = filepath.substr(lastSlash, count);
+
+		m_Program = ProgramFromName(m_Name);
+		if (m_Program == SoftwareProgram::None) {
+			SE_CORE_WARN("Software renderer has no program for shader '{0}', draws using it will be skipped", m_Name);
+		}
+	}
+
+	SoftwareShader::SoftwareShader(const std::string& name, const std::string&, const std::string&)
+		: m_Name(name), m_Program(ProgramFromName(name))
+	{
+	}
+
+	void SoftwareShader::Bind() const {
+		SoftwareRasterizer::BindShader(this);
+	}
+
+	void SoftwareShader::Unbind() const {
+		SoftwareRasterizer::BindShader(nullptr);
+	}
+
+	void SoftwareShader::SetFloat(const std::string& name, const float value) {
+		m_Vectors[name] = glm::vec4(value, 0.0f, 0.0f, 0.0f);
+	}
+
+	void SoftwareShader::SetFloat2(const std::string& name, const glm::vec2& value) {
+		m_Vectors[name] = glm::vec4(value, 0.0f, 0.0f);
+	}
+
+	void SoftwareShader::SetFloat3(const std::string& name, const glm::vec3& value) {
+		m_Vectors[name] = glm::vec4(value, 0.0f);
+	}
+
+	void SoftwareShader::SetFloat4(const std::string& name, const glm::vec4& value) {
+		m_Vectors[name] = value;
+	}
+
+	void SoftwareShader::SetMat4(const std::string& name, const glm::mat4& value) {
+		m_Matrices[name] = value;
+	}
+
+	void SoftwareShader::SetInt(const std::string& name, const int value) {
+		m_Ints[name] = value;
+	}
+
+	glm::vec4 SoftwareShader::GetVector(const std::string& name, const glm::vec4& fallback) const {
+		auto it = m_Vectors.find(name);
+		return it != m_Vectors.end() ? it->second : fallback;
+	}
+
+	SoftwareDrawState SoftwareShader::GetDrawState() const {
+		SoftwareDrawState state;
+		state.Program = m_Program;
+
+		auto vp = m_Matrices.find("u_ViewProjection");
+		if (vp != m_Matrices.end())
+			state.ViewProjection = vp->second;
+
+		auto transform = m_Matrices.find("u_Transform");
+		if (transform != m_Matrices.end())
+			state.Transform = transform->second;
+
+		auto texture = m_Ints.find("u_Texture");
+		if (texture != m_Ints.end())
+			state.TextureSlot = texture->second;
+
+		state.Color = GetVector("u_Color", glm::vec4(1.0f));
+		state.Scale = GetVector("u_Scale", glm::vec4(1.0f));
+		state.Offset = GetVector("u_Offset", glm::vec4(0.0f));
+		state.Depth = GetVector("u_Depth", glm::vec4(0.0f)).x;
+		state.Time = GetVector("u_Time", glm::vec4(0.0f)).x;
+		state.Animation = GetVector("u_Animation", glm::vec4(0.0f));
+		state.FrameCount = GetVector("u_FrameCount", glm::vec4(1.0f)).x;
+		state.AlphaCutoff = GetVector("u_AlphaCutoff", glm::vec4(0.0f)).x;
+
+		auto textured = m_Ints.find("u_Textured");
+		state.Textured = textured != m_Ints.end() && textured->second != 0;
+		return state;
+	}
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include "SurfEngine/Renderer/Shader.h"
+#include "SurfEngine/Platform/Software/SoftwareRasterizer.h"
+#include <glm/glm.hpp>
+
+namespace SurfEngine {
+	// Stores uniforms on the CPU and maps the shader file onto one of the rasterizer programs
+	class SoftwareShader : public Shader
+	{
+	public:
+		SoftwareShader(const std::string& filepath);
+		SoftwareShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
+		virtual ~SoftwareShader() = default;
+
+		void Bind() const override;
+		void Unbind() const override;
+
+		virtual void SetFloat(const std::string& name, const float value) override;
+		virtual void SetFloat2(const std::string& name, const glm::vec2& value) override;
+		virtual void SetFloat3(const std::string& name, const glm::vec3& value) override;
+		virtual void SetFloat4(const std::string& name, const glm::vec4& value) override;
+		virtual void SetMat4(const std::string& name, const glm::mat4& value) override;
+		virtual void SetInt(const std::string& name, const int value) override;
+
+		virtual const std::string& GetName() const override { return m_Name; };
+
+		SoftwareDrawState GetDrawState() const;
+	private:
+		glm::vec4 GetVector(const std::string& name, const glm::vec4& fallback) const;
+	private:
+		std::string m_Name;
+		SoftwareProgram m_Program = SoftwareProgram::None;
+		std::unordered_map<std::string, glm::vec4> m_Vectors;
+		std::unordered_map<std::string, glm::mat4> m_Matrices;
+		std::unordered_map<std::string, int> m_Ints;
+	};
+}
@@ -0,0 +1,60 @@
+#include "sepch.h"
+#include "SoftwareTexture.h"
+
+#include "stb_image.h"
+
+namespace SurfEngine {
+	SoftwareTexture2D::SoftwareTexture2D(const std::string& path)
+		: m_Path(path)
+	{
+		int width, height, channels;
+		stbi_set_flip_vertically_on_load(1);
+		stbi_uc* data = stbi_load(path.c_str(), &width, &height, &channels, 4);
+
+		if (data)
+		{
+			m_IsLoaded = true;
+
+			m_Image.Width = width;
+			m_Image.Height = height;
+			m_Image.Pixels.resize((size_t)width * height);
+			memcpy(m_Image.Pixels.data(), data, m_Image.Pixels.size() * sizeof(uint32_t));
+			m_AlphaMode = AnalyzeAlpha(data, (uint32_t)m_Image.Pixels.size(), 4);
+			m_AlphaCoverage = BuildAlphaCoverage(data, m_Image.Width, m_Image.Height, 4);
+
+			stbi_image_free(data);
+		}
+
+		m_RendererID = SoftwareRasterizer::RegisterImage(&m_Image);
+	}
+
+	SoftwareTexture2D::SoftwareTexture2D(uint32_t width, uint32_t height, Format format)
+		: m_Format(format)
+	{
+		m_Image.Width = width;
+		m_Image.Height = height;
+		//Float data textures are only read by shader features the software programs leave out
+		if (format == Format::RGBA8)
+			m_Image.Pixels.resize((size_t)width * height);
+		m_RendererID = SoftwareRasterizer::RegisterImage(&m_Image);
+	}
+
+	SoftwareTexture2D::~SoftwareTexture2D() {
+		SoftwareRasterizer::UnregisterImage(m_RendererID);
+	}
+
+	void SoftwareTexture2D::SetData(void* data, uint32_t size) {
+		if (m_Format == Format::RGBA32F)
+			return;
+
+		SE_CORE_ASSERT(size == m_Image.Pixels.size() * sizeof(uint32_t), "Data must be entire texture!");
+		memcpy(m_Image.Pixels.data(), data, size);
+		m_IsLoaded = true;
+		m_AlphaMode = AnalyzeAlpha((const unsigned char*)data, (uint32_t)m_Image.Pixels.size(), 4);
+		m_AlphaCoverage = BuildAlphaCoverage((const unsigned char*)data, m_Image.Width, m_Image.Height, 4);
+	}
+
+	void SoftwareTexture2D::Bind(uint32_t slot) const {
+		SoftwareRasterizer::BindTexture(slot, m_RendererID);
+	}
+}
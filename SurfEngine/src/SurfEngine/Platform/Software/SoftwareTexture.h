@@ -0,0 +1,32 @@
+#pragma once
+#include "SurfEngine/Renderer/Texture.h"
+#include "SurfEngine/Platform/Software/SoftwareRasterizer.h"
+
+namespace SurfEngine {
+	class SoftwareTexture2D : public Texture2D
+	{
+	public:
+		SoftwareTexture2D(const std::string& path);
+		SoftwareTexture2D(uint32_t width, uint32_t height, Format format);
+		virtual ~SoftwareTexture2D();
+
+		virtual uint32_t GetWidth() const  override { return m_Image.Width; }
+		virtual uint32_t GetHeight() const override { return m_Image.Height; }
+		virtual uint32_t GetRendererID() const override { return m_RendererID; }
+		virtual AlphaMode GetAlphaMode() const override { return m_AlphaMode; }
+		virtual const AlphaCoverage& GetAlphaCoverage() const override { return m_AlphaCoverage; }
+
+		virtual void SetData(void* data, uint32_t size) override;
+
+		virtual void Bind(uint32_t slot) const override;
+	private:
+		std::string m_Path;
+		bool m_IsLoaded = false;
+		SoftwareImage m_Image;
+		Format m_Format = Format::RGBA8;
+		uint32_t m_RendererID = 0;
+		AlphaMode m_AlphaMode = AlphaMode::Translucent;
+		AlphaCoverage m_AlphaCoverage;
+	};
+}
+
@@ -0,0 +1,46 @@
+#include "sepch.h"
+#include "SoftwareVertexArray.h"
+#include "SoftwareBuffer.h"
+
+namespace SurfEngine {
+
+	void SoftwareVertexArray::AddVertexBuffer(Ref<VertexBuffer>& vertexBuffer) {
+		SE_CORE_ASSERT(vertexBuffer->GetLayout().GetElements().size(), "Vertex Buffer has no layout!");
+		m_VertexBuffers.push_back(vertexBuffer);
+	}
+
+	void SoftwareVertexArray::SetIndexBuffer(Ref<IndexBuffer>& indexBuffer) {
+		m_IndexBuffer = indexBuffer;
+	}
+
+	void SoftwareVertexArray::FetchAttribute(uint32_t location, uint32_t index, float* out, uint32_t instance) const {
+		//Locations are assigned in layout order across all vertex buffers, same as the OpenGL backend
+		for (const auto& buffer : m_VertexBuffers) {
+			const auto& layout = buffer->GetLayout();
+			const auto& elements = layout.GetElements();
+			if (location >= elements.size()) {
+				location -= (uint32_t)elements.size();
+				continue;
+			}
+
+			const auto& element = elements[location];
+			if (layout.IsInstanced())
+				index = instance;
+			const auto& data = static_cast<const SoftwareVertexBuffer&>(*buffer).GetData();
+			size_t first = ((size_t)index * layout.GetStride() + element.Offset) / sizeof(float);
+			uint32_t count = element.GetComponentCount();
+			if (first + count > data.size())
+				return;
+			for (uint32_t i = 0; i < count; i++)
+				out[i] = data[first + i];
+			return;
+		}
+	}
+
+	uint32_t SoftwareVertexArray::GetVertexCount() const {
+		if (m_VertexBuffers.empty() || m_VertexBuffers[0]->GetLayout().GetStride() == 0 || m_VertexBuffers[0]->GetLayout().IsInstanced())
+			return 0;
+		const auto& data = static_cast<const SoftwareVertexBuffer&>(*m_VertexBuffers[0]).GetData();
+		return (uint32_t)(data.size() * sizeof(float) / m_VertexBuffers[0]->GetLayout().GetStride());
+	}
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "SurfEngine/Renderer/VertexArray.h"
+
+namespace SurfEngine {
+	class SoftwareVertexArray : public VertexArray
+	{
+	public:
+		SoftwareVertexArray() = default;
+		virtual ~SoftwareVertexArray() = default;
+
+		virtual void Bind() const override {}
+		virtual void Unbind() const override {}
+
+		virtual void AddVertexBuffer(Ref<VertexBuffer>& vertexBuffer) override;
+		virtual void SetIndexBuffer(Ref<IndexBuffer>& indexBuffer) override;
+
+		virtual const std::vector<Ref<VertexBuffer>>& GetVertexBuffers() const { return m_VertexBuffers; };
+		virtual const Ref<IndexBuffer>& GetIndexBuffer() const { return m_IndexBuffer; };
+
+		// Reads attribute 'location' of vertex 'index' into 'out', missing components are left untouched
+		// Instanced buffers are read at 'instance' instead
+		void FetchAttribute(uint32_t location, uint32_t index, float* out, uint32_t instance = 0) const;
+		uint32_t GetVertexCount() const;
+	private:
+		std::vector<Ref<VertexBuffer>> m_VertexBuffers;
+		Ref<IndexBuffer> m_IndexBuffer;
+	};
+}
+
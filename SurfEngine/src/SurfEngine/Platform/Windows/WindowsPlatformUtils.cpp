@@ -9,6 +9,11 @@
 
 #include "SurfEngine/Core/Application.h"
 
+//Older SDKs lack the flag, the timer itself exists since Windows 10 1803
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
 namespace SurfEngine {
 
 	std::string FileDialogs::OpenFile(const std::string& start_path, const char* filter)
@@ -63,4 +68,29 @@ namespace SurfEngine {
 		ShellExecuteA(NULL, "open", path.c_str(), NULL, NULL, SW_SHOWDEFAULT);
 	}
 
+	double Time::GetTime() {
+		return glfwGetTime();
+	}
+
+	void Time::Sleep(double seconds) {
+		if (seconds <= 0.0)
+			return;
+
+		//A plain waitable timer still rounds up to the scheduler tick, usually 15.6ms
+		static HANDLE timer = nullptr;
+		if (!timer) {
+			timer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+			if (!timer)
+				timer = CreateWaitableTimerExW(NULL, NULL, 0, TIMER_ALL_ACCESS);
+		}
+
+		//Negative due times are relative, in 100ns units
+		LARGE_INTEGER dueTime;
+		dueTime.QuadPart = -(LONGLONG)(seconds * 10000000.0);
+		if (timer && SetWaitableTimer(timer, &dueTime, 0, NULL, NULL, FALSE))
+			WaitForSingleObject(timer, INFINITE);
+		else
+			::Sleep((DWORD)(seconds * 1000.0));
+	}
+
 }
@@ -77,6 +77,16 @@ namespace SurfEngine {
 			data.EventCallback(event);
 			});
 
+		glfwSetWindowFocusCallback(m_Window, [](GLFWwindow* window, int focused) {
+			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+			data.Focused = focused == GLFW_TRUE;
+			});
+
+		glfwSetWindowIconifyCallback(m_Window, [](GLFWwindow* window, int iconified) {
+			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+			data.Minimized = iconified == GLFW_TRUE;
+			});
+
 		glfwSetKeyCallback(m_Window, [](GLFWwindow* window, int key, int scancode, int action, int mods) {
 			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
 			switch (action) {
@@ -146,6 +156,10 @@ namespace SurfEngine {
 		m_Context->SwapBuffers();
 	}
 
+	void WindowsWindow::WaitEvents(double timeout) {
+		glfwWaitEventsTimeout(timeout);
+	}
+
 	void WindowsWindow::SetVSync(bool enabled) {
 		if (enabled) {
 			glfwSwapInterval(1);
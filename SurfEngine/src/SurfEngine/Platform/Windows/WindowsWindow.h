@@ -22,6 +22,10 @@ namespace SurfEngine {
 		inline void SetEventCallback(const EventCallbackFn& callback) override { m_Data.EventCallback = callback; }
 		void SetVSync(bool enabled) override;
 		bool IsVSync() const override;
+		inline bool IsFocused() const override { return m_Data.Focused; }
+		inline bool IsMinimized() const override { return m_Data.Minimized; }
+
+		void WaitEvents(double timeout) override;
 
 		inline virtual void* GetNativeWindow() const { return m_Window;}
 	private:
@@ -35,6 +39,8 @@ namespace SurfEngine {
 			std::string Title;
 			unsigned int Width, Height, posX, posY;
 			bool VSync;
+			bool Focused = true;
+			bool Minimized = false;
 			EventCallbackFn EventCallback;
 		};
 		WindowData m_Data;
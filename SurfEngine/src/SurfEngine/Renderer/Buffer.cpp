@@ -2,21 +2,34 @@
 #include "Buffer.h"
 #include "Renderer.h"
 #include "SurfEngine/Platform/OpenGl/OpenGLBuffer.h"
+#include "SurfEngine/Platform/Software/SoftwareBuffer.h"
 
 namespace SurfEngine {
 	VertexBuffer* VertexBuffer::Create(float* vertices, uint32_t size) {
 		switch (Renderer::GetAPI()) {
 			case RendererAPI::API::None: SE_CORE_ASSERT(false, "Renderer API not supported"); return nullptr;
 			case RendererAPI::API::OpenGL: return new OpenGLVertexBuffer(vertices,size);
+			case RendererAPI::API::Software: return new SoftwareVertexBuffer(vertices, size);
 		}
 		SE_CORE_ASSERT(false, "Unknown Renderer API Specified");
 		return nullptr;
 	} 
 
+	VertexBuffer* VertexBuffer::Create(uint32_t size) {
+		switch (Renderer::GetAPI()) {
+			case RendererAPI::API::None: SE_CORE_ASSERT(false, "Renderer API not supported"); return nullptr;
+			case RendererAPI::API::OpenGL: return new OpenGLVertexBuffer(size);
+			case RendererAPI::API::Software: return new SoftwareVertexBuffer(size);
+		}
+		SE_CORE_ASSERT(false, "Unknown Renderer API Specified");
+		return nullptr;
+	}
+
 	IndexBuffer* IndexBuffer::Create(uint32_t* indices, uint32_t size) {
 		switch (Renderer::GetAPI()) {
 			case RendererAPI::API::None: SE_CORE_ASSERT(false, "Renderer API not supported"); return nullptr;
 			case RendererAPI::API::OpenGL: return new OpenGLIndexBuffer(indices, size);
+			case RendererAPI::API::Software: return new SoftwareIndexBuffer(indices, size);
 		}
 		SE_CORE_ASSERT(false, "Unknown Renderer API Specified");
 		return nullptr;
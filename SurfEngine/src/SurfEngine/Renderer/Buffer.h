@@ -69,6 +69,10 @@ namespace SurfEngine {
 
 		inline uint32_t GetStride() const { return m_Stride; }
 		inline const std::vector<BufferElement>& GetElements() const { return m_Elements; }
+
+		// Instanced layouts advance once per instance instead of once per vertex
+		inline bool IsInstanced() const { return m_Instanced; }
+		inline void SetInstanced(bool instanced) { m_Instanced = instanced; }
 		
 		std::vector<BufferElement>::iterator begin() { return m_Elements.begin(); }
 		std::vector<BufferElement>::iterator end() { return m_Elements.end(); }
@@ -88,6 +92,7 @@ namespace SurfEngine {
 	private:
 		std::vector<BufferElement> m_Elements;
 		uint32_t m_Stride = 0;
+		bool m_Instanced = false;
 	};
 
 
@@ -101,7 +106,11 @@ namespace SurfEngine {
 		virtual const BufferLayout& GetLayout() const = 0;
 		virtual void SetLayout(const BufferLayout& layout) = 0;
 
+		// Only valid on buffers created with a size, data must fit in that size
+		virtual void SetData(const void* data, uint32_t size) = 0;
+
 		static VertexBuffer* Create(float* vertices, uint32_t size);
+		static VertexBuffer* Create(uint32_t size);
 	};
 
 	class IndexBuffer {
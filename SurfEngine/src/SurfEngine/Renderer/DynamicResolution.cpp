@@ -0,0 +1,89 @@
+#include "sepch.h"
+#include "DynamicResolution.h"
+
+#include "RenderCommand.h"
+#include <glm/glm.hpp>
+
+namespace SurfEngine {
+
+	// Timings finished in the first frames after a scale change still measured the old size
+	static const uint32_t s_TimerLatencyFrames = 4;
+	// Frames after a scale change before the next one, gives the new size a few timings
+	static const uint32_t s_SettleFrames = 8;
+	// Largest change of the scale per adjustment
+	static const float s_MaxStep = 0.1f;
+	// Only scale up once the frame fits well inside the budget, keeps the scale from oscillating
+	static const float s_GrowThreshold = 0.85f;
+	// Scales are snapped to this step so small timing noise does not resize the target
+	static const float s_ScaleGranularity = 1.0f / 32.0f;
+
+	struct DynamicResolutionData {
+		DynamicResolution::Settings Settings;
+		DynamicResolution::Statistics Stats;
+		float Scale = 1.0f;
+		float SmoothedTime = -1.0f;
+		uint32_t FramesSinceChange = 0;
+	};
+
+	static DynamicResolutionData* s_Data = nullptr;
+
+	void DynamicResolution::Init() {
+		s_Data = new DynamicResolutionData();
+	}
+
+	void DynamicResolution::Shutdown() {
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	DynamicResolution::Settings& DynamicResolution::GetSettings() {
+		return s_Data->Settings;
+	}
+
+	const DynamicResolution::Statistics& DynamicResolution::GetStats() {
+		return s_Data->Stats;
+	}
+
+	float DynamicResolution::BeginFrame() {
+		const Settings& settings = s_Data->Settings;
+		float gpuTime = RenderCommand::GetGPUTime();
+		s_Data->FramesSinceChange++;
+
+		if (gpuTime >= 0.0f)
+			s_Data->Stats.GPUTime = gpuTime;
+		if (gpuTime >= 0.0f && s_Data->FramesSinceChange > s_TimerLatencyFrames) {
+			s_Data->SmoothedTime = s_Data->SmoothedTime < 0.0f ? gpuTime : glm::mix(s_Data->SmoothedTime, gpuTime, 0.2f);
+		}
+
+		float minScale = glm::clamp(std::min(settings.MinScale, settings.MaxScale), 0.1f, 1.0f);
+		float maxScale = glm::clamp(settings.MaxScale, minScale, 1.0f);
+		float scale = s_Data->Scale;
+		if (!settings.Enabled) {
+			scale = 1.0f;
+		}
+		else if (s_Data->SmoothedTime > 0.0f && s_Data->FramesSinceChange >= s_SettleFrames) {
+			//Fill cost follows the pixel count, so the edge length goes with the square root of the time ratio
+			float time = s_Data->SmoothedTime;
+			float budget = std::max(settings.TargetFrameTime, 0.1f);
+			if (time > budget || time < budget * s_GrowThreshold) {
+				float ideal = scale * std::sqrt(budget * s_GrowThreshold / time);
+				scale = glm::clamp(ideal, scale - s_MaxStep, scale + s_MaxStep);
+			}
+		}
+		scale = glm::clamp(std::round(scale / s_ScaleGranularity) * s_ScaleGranularity, settings.Enabled ? minScale : 1.0f, settings.Enabled ? maxScale : 1.0f);
+
+		if (scale != s_Data->Scale) {
+			s_Data->Scale = scale;
+			s_Data->FramesSinceChange = 0;
+			s_Data->SmoothedTime = -1.0f;
+		}
+		s_Data->Stats.Scale = scale;
+
+		RenderCommand::BeginGPUTimer();
+		return scale;
+	}
+
+	void DynamicResolution::EndFrame() {
+		RenderCommand::EndGPUTimer();
+	}
+}
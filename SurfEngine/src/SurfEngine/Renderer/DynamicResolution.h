@@ -0,0 +1,35 @@
+#pragma once
+
+namespace SurfEngine {
+
+	// Scales the scene render target between MinScale and MaxScale of the output size to hold a GPU frame time
+	// Post processing upscales the result to the output with a sharpening filter. GPU timings arrive a few
+	// frames late, so the scale moves in bounded steps and waits for timings of the new size before moving again
+	class DynamicResolution {
+	public:
+		struct Settings {
+			bool Enabled = false;
+			// Milliseconds of GPU time the scene may take
+			float TargetFrameTime = 16.6f;
+			float MinScale = 0.5f;
+			float MaxScale = 1.0f;
+			// 0 is a plain bilinear upscale
+			float Sharpness = 0.5f;
+		};
+
+		struct Statistics {
+			float GPUTime = 0.0f;
+			float Scale = 1.0f;
+		};
+	public:
+		static void Init();
+		static void Shutdown();
+
+		static Settings& GetSettings();
+		static const Statistics& GetStats();
+
+		// Picks the frame's render scale from the newest finished timing and starts timing the frame
+		static float BeginFrame();
+		static void EndFrame();
+	};
+}
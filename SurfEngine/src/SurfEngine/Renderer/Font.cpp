@@ -0,0 +1,137 @@
+#include "sepch.h"
+#include "Font.h"
+
+#include <fstream>
+
+#define STBTT_STATIC
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "imstb_truetype.h"
+
+namespace SurfEngine {
+
+	static const uint32_t s_GlyphCount = Font::LastCodepoint - Font::FirstCodepoint + 1;
+	// Size the distance field is rendered at, text is scaled from it on the GPU
+	static const float s_GlyphPixelHeight = 48.0f;
+	// Texels of distance kept around every glyph, the field fades to 0 over this range
+	static const int s_GlyphPadding = 6;
+	static const unsigned char s_OnEdgeValue = 128;
+	static const uint32_t s_AtlasWidth = 512;
+
+	namespace Utils {
+
+		static bool ReadFile(const std::string& path, std::vector<unsigned char>& data) {
+			std::ifstream in(path, std::ios::in | std::ios::binary);
+			if (!in)
+				return false;
+			in.seekg(0, std::ios::end);
+			data.resize((size_t)in.tellg());
+			in.seekg(0, std::ios::beg);
+			in.read((char*)data.data(), data.size());
+			return !data.empty();
+		}
+
+		static uint32_t NextPowerOfTwo(uint32_t value) {
+			uint32_t result = 1;
+			while (result < value)
+				result <<= 1;
+			return result;
+		}
+	}
+
+	Ref<Font> Font::Create(const std::string& path) {
+		std::vector<unsigned char> data;
+		stbtt_fontinfo info;
+		if (!Utils::ReadFile(path, data) || !stbtt_InitFont(&info, data.data(), stbtt_GetFontOffsetForIndex(data.data(), 0))) {
+			SE_CORE_ERROR("Failed to load font '{0}'", path);
+			return nullptr;
+		}
+
+		Ref<Font> font = std::make_shared<Font>();
+		font->m_Path = path;
+		font->m_Glyphs.resize(s_GlyphCount);
+
+		const float scale = stbtt_ScaleForPixelHeight(&info, s_GlyphPixelHeight);
+		const float toEm = scale / s_GlyphPixelHeight;
+		int ascent, descent, lineGap;
+		stbtt_GetFontVMetrics(&info, &ascent, &descent, &lineGap);
+		font->m_LineHeight = (ascent - descent + lineGap) * toEm;
+
+		struct GlyphBitmap {
+			unsigned char* Pixels = nullptr;
+			int Width = 0, Height = 0;
+			uint32_t X = 0, Y = 0;
+		};
+		std::vector<GlyphBitmap> bitmaps(s_GlyphCount);
+
+		//Shelf packing in codepoint order, glyphs of one font are close enough in height
+		uint32_t penX = 0, penY = 0, shelfHeight = 0;
+		for (uint32_t i = 0; i < s_GlyphCount; i++) {
+			uint32_t codepoint = FirstCodepoint + i;
+			Glyph& glyph = font->m_Glyphs[i];
+			GlyphBitmap& bitmap = bitmaps[i];
+
+			int advance, leftBearing, xOffset, yOffset;
+			stbtt_GetCodepointHMetrics(&info, codepoint, &advance, &leftBearing);
+			glyph.Advance = advance * toEm;
+
+			bitmap.Pixels = stbtt_GetCodepointSDF(&info, scale, codepoint, s_GlyphPadding, s_OnEdgeValue, (float)s_OnEdgeValue / s_GlyphPadding,
+				&bitmap.Width, &bitmap.Height, &xOffset, &yOffset);
+			if (!bitmap.Pixels)
+				continue;
+
+			if (penX + bitmap.Width > s_AtlasWidth) {
+				penX = 0;
+				penY += shelfHeight + 1;
+				shelfHeight = 0;
+			}
+			bitmap.X = penX;
+			bitmap.Y = penY;
+			penX += bitmap.Width + 1;
+			shelfHeight = std::max(shelfHeight, (uint32_t)bitmap.Height);
+
+			glyph.PlaneMin = glm::vec2((float)xOffset, (float)yOffset) / s_GlyphPixelHeight;
+			glyph.PlaneMax = glm::vec2((float)(xOffset + bitmap.Width), (float)(yOffset + bitmap.Height)) / s_GlyphPixelHeight;
+		}
+
+		//White texels carrying the distance in alpha, atlas rows map to v top down
+		const uint32_t atlasHeight = Utils::NextPowerOfTwo(penY + shelfHeight);
+		std::vector<uint32_t> pixels((size_t)s_AtlasWidth * atlasHeight, 0x00FFFFFFu);
+		for (uint32_t i = 0; i < s_GlyphCount; i++) {
+			GlyphBitmap& bitmap = bitmaps[i];
+			if (!bitmap.Pixels)
+				continue;
+
+			for (int y = 0; y < bitmap.Height; y++)
+				for (int x = 0; x < bitmap.Width; x++)
+					pixels[(size_t)(bitmap.Y + y) * s_AtlasWidth + bitmap.X + x] = 0x00FFFFFFu | ((uint32_t)bitmap.Pixels[y * bitmap.Width + x] << 24);
+
+			Glyph& glyph = font->m_Glyphs[i];
+			glyph.UVMin = glm::vec2((float)bitmap.X / s_AtlasWidth, (float)bitmap.Y / atlasHeight);
+			glyph.UVMax = glm::vec2((float)(bitmap.X + bitmap.Width) / s_AtlasWidth, (float)(bitmap.Y + bitmap.Height) / atlasHeight);
+			stbtt_FreeSDF(bitmap.Pixels, nullptr);
+		}
+
+		font->m_Atlas = Texture2D::Create(s_AtlasWidth, atlasHeight);
+		font->m_Atlas->SetData(pixels.data(), (uint32_t)(pixels.size() * sizeof(uint32_t)));
+
+		//Kerning pairs are looked up per glyph during layout, so resolve them once here
+		font->m_Kerning.resize((size_t)s_GlyphCount * s_GlyphCount);
+		for (uint32_t first = 0; first < s_GlyphCount; first++)
+			for (uint32_t second = 0; second < s_GlyphCount; second++)
+				font->m_Kerning[(size_t)first * s_GlyphCount + second] = stbtt_GetCodepointKernAdvance(&info, FirstCodepoint + first, FirstCodepoint + second) * toEm;
+
+		return font;
+	}
+
+	const Font::Glyph* Font::GetGlyph(uint32_t codepoint) const {
+		if (codepoint < FirstCodepoint || codepoint > LastCodepoint)
+			return nullptr;
+		return &m_Glyphs[codepoint - FirstCodepoint];
+	}
+
+	float Font::GetKerning(uint32_t first, uint32_t second) const {
+		if (first < FirstCodepoint || first > LastCodepoint || second < FirstCodepoint || second > LastCodepoint)
+			return 0.0f;
+		return m_Kerning[(size_t)(first - FirstCodepoint) * s_GlyphCount + (second - FirstCodepoint)];
+	}
+}
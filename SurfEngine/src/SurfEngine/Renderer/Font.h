@@ -0,0 +1,38 @@
+#pragma once
+#include "Texture.h"
+#include <glm/glm.hpp>
+
+namespace SurfEngine {
+
+	// Signed distance field atlas for the printable ASCII range of a TrueType font
+	// Metrics are in em units with y growing downwards from the baseline, the same way as world space
+	class Font {
+	public:
+		static const uint32_t FirstCodepoint = 32;
+		static const uint32_t LastCodepoint = 126;
+
+		struct Glyph {
+			glm::vec2 UVMin = glm::vec2(0.0f), UVMax = glm::vec2(0.0f);
+			// Quad corners relative to the pen position, empty for whitespace
+			glm::vec2 PlaneMin = glm::vec2(0.0f), PlaneMax = glm::vec2(0.0f);
+			float Advance = 0.0f;
+		};
+
+		// Returns nullptr when the file can't be read or isn't a font
+		static Ref<Font> Create(const std::string& path);
+
+		// nullptr for codepoints outside the atlas
+		const Glyph* GetGlyph(uint32_t codepoint) const;
+		float GetKerning(uint32_t first, uint32_t second) const;
+		float GetLineHeight() const { return m_LineHeight; }
+
+		const Ref<Texture2D>& GetAtlas() const { return m_Atlas; }
+		const std::string& GetPath() const { return m_Path; }
+	private:
+		std::string m_Path;
+		Ref<Texture2D> m_Atlas;
+		std::vector<Glyph> m_Glyphs;
+		std::vector<float> m_Kerning;
+		float m_LineHeight = 1.0f;
+	};
+}
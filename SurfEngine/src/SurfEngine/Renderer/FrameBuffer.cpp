@@ -2,12 +2,14 @@
 #include "FrameBuffer.h"
 #include "Renderer.h"
 #include "SurfEngine/Platform/OpenGl/OpenGLFrameBuffer.h"
+#include "SurfEngine/Platform/Software/SoftwareFrameBuffer.h"
 
 namespace SurfEngine{
 	Ref<Framebuffer> Framebuffer::Create(const FramebufferSpecification& spec) {
 		switch (Renderer::GetAPI()) {
 			case RendererAPI::API::None:	SE_CORE_ASSERT(false, "Renderer API not supported"); return nullptr;
 			case RendererAPI::API::OpenGL:	return std::make_shared<OpenGLFramebuffer>(spec);
+			case RendererAPI::API::Software:	return std::make_shared<SoftwareFramebuffer>(spec);
 		}
 		SE_CORE_ASSERT(false, "Unknown Renderer API Specified");
 		return nullptr;
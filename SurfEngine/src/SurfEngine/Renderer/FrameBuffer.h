@@ -1,4 +1,6 @@
 #pragma once
+#include <glm/glm.hpp>
+
 namespace SurfEngine {
 
 	enum class FramebufferTextureFormat
@@ -61,6 +63,10 @@ namespace SurfEngine {
 
 		virtual const FramebufferSpecification& GetSpecification() const = 0;
 
+		// Attachments can be allocated larger than the specification so resizes do not reallocate,
+		// scale texture coordinates by this when sampling a color attachment
+		virtual glm::vec2 GetUVScale() const { return glm::vec2(1.0f); }
+
 		static Ref<Framebuffer> Create(const FramebufferSpecification& spec);
 	};
 
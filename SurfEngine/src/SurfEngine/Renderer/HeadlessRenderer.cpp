@@ -0,0 +1,63 @@
+#include "sepch.h"
+#include "HeadlessRenderer.h"
+#include "RenderCommand.h"
+#include "Renderer2D.h"
+#include "RenderTargetPool.h"
+#include "SurfEngine/Core/JobSystem.h"
+#include "SurfEngine/Scenes/Scene.h"
+#include "SurfEngine/Platform/Software/SoftwareFrameBuffer.h"
+
+namespace SurfEngine {
+
+	struct HeadlessRendererData {
+		HeadlessRenderer::Image Image;
+	};
+
+	static HeadlessRendererData* s_Data = nullptr;
+
+	void HeadlessRenderer::Init(uint32_t width, uint32_t height) {
+		SE_CORE_ASSERT(!s_Data, "HeadlessRenderer already initialized");
+		s_Data = new HeadlessRendererData();
+
+		//Everything Application and the editor layer would set up, minus the window and ImGui
+		RendererAPI::SetAPI(RendererAPI::API::Software);
+		JobSystem::Init();
+		RenderCommand::Init();
+		RenderCommand::EnableTextures();
+		RenderCommand::EnableBlending();
+		Renderer2D::Init();
+
+		FramebufferSpecification fbSpec;
+		fbSpec.Attachments = { FramebufferTextureFormat::RGBA8 , FramebufferTextureFormat::RED_INTEGER, FramebufferTextureFormat::Depth };
+		fbSpec.Width = width;
+		fbSpec.Height = height;
+		Renderer2D::SetRenderTarget(Framebuffer::Create(fbSpec));
+	}
+
+	void HeadlessRenderer::Shutdown() {
+		Renderer2D::Shutdown();
+		JobSystem::Shutdown();
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	void HeadlessRenderer::Resize(uint32_t width, uint32_t height) {
+		Renderer2D::SetRenderSize(width, height);
+	}
+
+	const HeadlessRenderer::Image& HeadlessRenderer::RenderScene(Scene& scene, const Camera& camera) {
+		SE_CORE_ASSERT(s_Data, "HeadlessRenderer not initialized");
+		scene.Render(camera);
+
+		//With post processing on the final image is in a pooled target rather than the render target
+		SoftwareFramebuffer& output = static_cast<SoftwareFramebuffer&>(*Renderer2D::GetOutput());
+		const FramebufferSpecification& spec = output.GetSpecification();
+		s_Data->Image.Width = spec.Width;
+		s_Data->Image.Height = spec.Height;
+		s_Data->Image.Pixels = output.GetColorAttachmentData(0);
+
+		//Pooled targets are only handed back once the frame has been read
+		RenderTargetPool::EndFrame();
+		return s_Data->Image;
+	}
+}
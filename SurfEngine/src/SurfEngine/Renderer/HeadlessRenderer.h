@@ -0,0 +1,26 @@
+#pragma once
+#include "Camera.h"
+
+namespace SurfEngine {
+	class Scene;
+
+	// Renders scenes into memory on the software renderer, with no window, GL context or ImGui
+	// Used in place of Application for thumbnails and on machines without a GPU, Init must come
+	// before any scene is loaded as textures are created for the renderer API active at the time
+	class HeadlessRenderer {
+	public:
+		// RGBA8 packed as R | G << 8 | B << 16 | A << 24, row 0 is the bottom row
+		struct Image {
+			uint32_t Width = 0, Height = 0;
+			std::vector<uint32_t> Pixels;
+		};
+	public:
+		static void Init(uint32_t width, uint32_t height);
+		static void Shutdown();
+
+		static void Resize(uint32_t width, uint32_t height);
+		// Draws the scene as seen through camera, without editor overlays and without running its systems
+		// The image stays valid until the next call
+		static const Image& RenderScene(Scene& scene, const Camera& camera);
+	};
+}
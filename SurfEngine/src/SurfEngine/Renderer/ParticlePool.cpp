@@ -0,0 +1,196 @@
+#include "sepch.h"
+#include "ParticlePool.h"
+#include "SurfEngine/Scenes/Components.h"
+#include "SurfEngine/Core/JobSystem.h"
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define SE_PARTICLE_SSE 1
+	#include <emmintrin.h>
+#else
+	#define SE_PARTICLE_SSE 0
+#endif
+
+namespace SurfEngine {
+
+	static const uint32_t s_BatchSize = 4096;
+
+	ParticlePool::ParticlePool(uint32_t maxParticles)
+		: m_Capacity(maxParticles)
+	{
+		m_PositionX.resize(m_Capacity);
+		m_PositionY.resize(m_Capacity);
+		m_VelocityX.resize(m_Capacity);
+		m_VelocityY.resize(m_Capacity);
+		m_Age.resize(m_Capacity);
+		m_InverseLifetime.resize(m_Capacity);
+		m_Instances.resize((size_t)m_Capacity * InstanceStride);
+	}
+
+	void ParticlePool::Update(const ParticleEmitterComponent& emitter, const glm::vec2& origin, Timestep ts) {
+		float dt = ts;
+
+		if (m_Count > s_BatchSize) {
+			uint32_t batches = (m_Count + s_BatchSize - 1) / s_BatchSize;
+			JobSystem::ParallelFor(batches, 1, [&](uint32_t first, uint32_t last) {
+				for (uint32_t batch = first; batch < last; batch++)
+					UpdateRange(emitter, dt, batch * s_BatchSize, std::min((batch + 1) * s_BatchSize, m_Count));
+			});
+		}
+		else if (m_Count > 0) {
+			UpdateRange(emitter, dt, 0, m_Count);
+		}
+
+		//Swap dead particles with the last live one
+		for (uint32_t i = 0; i < m_Count;) {
+			if (m_Age[i] * m_InverseLifetime[i] < 1.0f) {
+				i++;
+				continue;
+			}
+
+			uint32_t last = --m_Count;
+			m_PositionX[i] = m_PositionX[last];
+			m_PositionY[i] = m_PositionY[last];
+			m_VelocityX[i] = m_VelocityX[last];
+			m_VelocityY[i] = m_VelocityY[last];
+			m_Age[i] = m_Age[last];
+			m_InverseLifetime[i] = m_InverseLifetime[last];
+			memcpy(&m_Instances[(size_t)i * InstanceStride], &m_Instances[(size_t)last * InstanceStride], InstanceStride * sizeof(float));
+		}
+
+		if (emitter.Emitting) {
+			m_EmitAccumulator += emitter.EmissionRate * dt;
+			uint32_t count = (uint32_t)m_EmitAccumulator;
+			m_EmitAccumulator -= (float)count;
+			Emit(emitter, origin, std::min(count, m_Capacity - m_Count));
+		}
+
+		m_Uploaded = false;
+	}
+
+	void ParticlePool::Clear() {
+		m_Count = 0;
+		m_EmitAccumulator = 0.0f;
+		m_Uploaded = false;
+	}
+
+	void ParticlePool::Emit(const ParticleEmitterComponent& emitter, const glm::vec2& origin, uint32_t count) {
+		uint32_t begin = m_Count;
+		for (uint32_t i = begin; i < begin + count; i++) {
+			float lifetime = emitter.Lifetime * (1.0f + emitter.LifetimeVariation * (Random() * 2.0f - 1.0f));
+			m_PositionX[i] = origin.x;
+			m_PositionY[i] = origin.y;
+			m_VelocityX[i] = emitter.Velocity.x + emitter.VelocityVariation.x * (Random() * 2.0f - 1.0f);
+			m_VelocityY[i] = emitter.Velocity.y + emitter.VelocityVariation.y * (Random() * 2.0f - 1.0f);
+			m_Age[i] = 0.0f;
+			m_InverseLifetime[i] = 1.0f / std::max(lifetime, 0.001f);
+		}
+		m_Count += count;
+		WriteInstances(emitter, begin, m_Count);
+	}
+
+	void ParticlePool::UpdateRange(const ParticleEmitterComponent& emitter, float dt, uint32_t begin, uint32_t end) {
+		const float drag = std::max(1.0f - emitter.Drag * dt, 0.0f);
+		const glm::vec2 gravity = emitter.Gravity * dt;
+
+		uint32_t i = begin;
+#if SE_PARTICLE_SSE
+		const __m128 vDt = _mm_set1_ps(dt);
+		const __m128 vDrag = _mm_set1_ps(drag);
+		const __m128 vGravityX = _mm_set1_ps(gravity.x);
+		const __m128 vGravityY = _mm_set1_ps(gravity.y);
+		for (; i + 4 <= end; i += 4) {
+			__m128 velocityX = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(&m_VelocityX[i]), vGravityX), vDrag);
+			__m128 velocityY = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(&m_VelocityY[i]), vGravityY), vDrag);
+			_mm_storeu_ps(&m_VelocityX[i], velocityX);
+			_mm_storeu_ps(&m_VelocityY[i], velocityY);
+			_mm_storeu_ps(&m_PositionX[i], _mm_add_ps(_mm_loadu_ps(&m_PositionX[i]), _mm_mul_ps(velocityX, vDt)));
+			_mm_storeu_ps(&m_PositionY[i], _mm_add_ps(_mm_loadu_ps(&m_PositionY[i]), _mm_mul_ps(velocityY, vDt)));
+			_mm_storeu_ps(&m_Age[i], _mm_add_ps(_mm_loadu_ps(&m_Age[i]), vDt));
+		}
+#endif
+		for (; i < end; i++) {
+			m_VelocityX[i] = (m_VelocityX[i] + gravity.x) * drag;
+			m_VelocityY[i] = (m_VelocityY[i] + gravity.y) * drag;
+			m_PositionX[i] += m_VelocityX[i] * dt;
+			m_PositionY[i] += m_VelocityY[i] * dt;
+			m_Age[i] += dt;
+		}
+
+		WriteInstances(emitter, begin, end);
+	}
+
+	void ParticlePool::WriteInstances(const ParticleEmitterComponent& emitter, uint32_t begin, uint32_t end) {
+		//Color and size curves are linear over the normalized age
+		const float sizeDelta = emitter.SizeEnd - emitter.SizeBegin;
+#if SE_PARTICLE_SSE
+		const __m128 colorBegin = _mm_loadu_ps(&emitter.ColorBegin.x);
+		const __m128 colorDelta = _mm_sub_ps(_mm_loadu_ps(&emitter.ColorEnd.x), colorBegin);
+#else
+		const glm::vec4 colorDelta = emitter.ColorEnd - emitter.ColorBegin;
+#endif
+		for (uint32_t i = begin; i < end; i++) {
+			float t = std::min(m_Age[i] * m_InverseLifetime[i], 1.0f);
+			float* instance = &m_Instances[(size_t)i * InstanceStride];
+			instance[0] = m_PositionX[i];
+			instance[1] = m_PositionY[i];
+			instance[2] = emitter.SizeBegin + sizeDelta * t;
+#if SE_PARTICLE_SSE
+			_mm_storeu_ps(&instance[3], _mm_add_ps(colorBegin, _mm_mul_ps(colorDelta, _mm_set1_ps(t))));
+#else
+			glm::vec4 color = emitter.ColorBegin + colorDelta * t;
+			memcpy(&instance[3], &color.x, sizeof(color));
+#endif
+		}
+	}
+
+	const Ref<VertexArray>& ParticlePool::GetVertexArray() {
+		if (!m_VertexArray) {
+			//Quad Verticies x,y,z, texX, texY
+			float SquareVertices[5 * 4] = {
+				0.5f, 0.5f, 0.0f, 1.0f, 0.0f,
+			   -0.5f, 0.5f, 0.0f, 0.0f, 0.0f,
+			   -0.5f, -0.5f, 0.0f, 0.0f, 1.0f,
+				0.5f, -0.5f, 0.0f, 1.0f, 1.0f,
+			};
+			uint32_t squareindices[6] = { 0, 1, 2, 2, 3, 0 };
+
+			Ref<VertexBuffer> squareVB;
+			squareVB.reset(VertexBuffer::Create(SquareVertices, sizeof(SquareVertices)));
+			squareVB->SetLayout({
+				{ShaderDataType::Float3, "a_Position"},
+				{ShaderDataType::Float2, "a_TexCoord"},
+				});
+
+			BufferLayout instanceLayout = {
+				{ShaderDataType::Float3, "i_PositionSize"},
+				{ShaderDataType::Float4, "i_Color"},
+			};
+			instanceLayout.SetInstanced(true);
+			m_InstanceBuffer.reset(VertexBuffer::Create(m_Capacity * InstanceStride * (uint32_t)sizeof(float)));
+			m_InstanceBuffer->SetLayout(instanceLayout);
+
+			std::shared_ptr<IndexBuffer> squareIB;
+			squareIB.reset(IndexBuffer::Create(squareindices, 6));
+
+			m_VertexArray = VertexArray::Create();
+			m_VertexArray->AddVertexBuffer(squareVB);
+			m_VertexArray->AddVertexBuffer(m_InstanceBuffer);
+			m_VertexArray->SetIndexBuffer(squareIB);
+			m_Uploaded = false;
+		}
+
+		if (!m_Uploaded && m_Count > 0) {
+			m_InstanceBuffer->SetData(m_Instances.data(), m_Count * InstanceStride * (uint32_t)sizeof(float));
+			m_Uploaded = true;
+		}
+		return m_VertexArray;
+	}
+
+	//xorshift32
+	float ParticlePool::Random() {
+		m_Seed ^= m_Seed << 13;
+		m_Seed ^= m_Seed >> 17;
+		m_Seed ^= m_Seed << 5;
+		return (float)(m_Seed >> 8) / (float)(1u << 24);
+	}
+}
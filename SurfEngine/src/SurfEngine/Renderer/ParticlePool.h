@@ -0,0 +1,48 @@
+#pragma once
+#include "SurfEngine/Core/Timestep.h"
+#include "VertexArray.h"
+#include <glm/glm.hpp>
+
+namespace SurfEngine {
+	struct ParticleEmitterComponent;
+
+	// Structure of arrays particle storage for one emitter, live particles are packed at the front
+	// Large pools are updated in parallel batches, the kernels work on four particles at a time
+	class ParticlePool {
+	public:
+		// Per instance data uploaded for the instanced draw: x, y, size, r, g, b, a
+		static const uint32_t InstanceStride = 7;
+
+		ParticlePool(uint32_t maxParticles);
+
+		// Ages, moves and culls live particles, then emits new ones at origin
+		void Update(const ParticleEmitterComponent& emitter, const glm::vec2& origin, Timestep ts);
+		void Clear();
+
+		uint32_t GetCount() const { return m_Count; }
+		uint32_t GetCapacity() const { return m_Capacity; }
+
+		// Unit quad plus the instance buffer, uploaded if particles changed since the last call
+		const Ref<VertexArray>& GetVertexArray();
+	private:
+		void Emit(const ParticleEmitterComponent& emitter, const glm::vec2& origin, uint32_t count);
+		void UpdateRange(const ParticleEmitterComponent& emitter, float dt, uint32_t begin, uint32_t end);
+		void WriteInstances(const ParticleEmitterComponent& emitter, uint32_t begin, uint32_t end);
+		float Random();
+	private:
+		uint32_t m_Capacity = 0;
+		uint32_t m_Count = 0;
+
+		std::vector<float> m_PositionX, m_PositionY;
+		std::vector<float> m_VelocityX, m_VelocityY;
+		std::vector<float> m_Age, m_InverseLifetime;
+		std::vector<float> m_Instances;
+
+		float m_EmitAccumulator = 0.0f;
+		uint32_t m_Seed = 0x9E3779B9u;
+
+		Ref<VertexArray> m_VertexArray;
+		Ref<VertexBuffer> m_InstanceBuffer;
+		bool m_Uploaded = false;
+	};
+}
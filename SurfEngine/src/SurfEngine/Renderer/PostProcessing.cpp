@@ -0,0 +1,206 @@
+#include "sepch.h"
+#include "PostProcessing.h"
+
+#include "Renderer.h"
+#include "Shader.h"
+#include "RenderCommand.h"
+#include "DynamicResolution.h"
+
+namespace SurfEngine {
+
+	struct PostProcessingData {
+		PostProcessing::Settings Settings;
+		// Clip space triangle covering the screen, texture coordinates are derived from the position
+		Ref<VertexArray> FullscreenTriangle;
+		Ref<Shader> Prefilter;
+		Ref<Shader> Blur;
+		Ref<Shader> Composite;
+		// The final image outlives the graph, the viewport samples it after the frame
+		Ref<Framebuffer> Output;
+	};
+
+	static PostProcessingData* s_Data = nullptr;
+
+	void PostProcessing::Init() {
+		s_Data = new PostProcessingData();
+
+		//The software rasterizer has no programs for these, it always shows the scene color
+		if (Renderer::GetAPI() != RendererAPI::API::OpenGL)
+			return;
+
+		s_Data->Prefilter = Shader::Create("res/shaders/postprocess_prefilter.glsl");
+		s_Data->Blur = Shader::Create("res/shaders/postprocess_blur.glsl");
+		s_Data->Composite = Shader::Create("res/shaders/postprocess_composite.glsl");
+
+		float vertices[2 * 3] = {
+			-1.0f, -1.0f,
+			 3.0f, -1.0f,
+			-1.0f,  3.0f,
+		};
+		uint32_t indices[3] = { 0, 1, 2 };
+
+		Ref<VertexBuffer> vertexBuffer;
+		vertexBuffer.reset(VertexBuffer::Create(vertices, sizeof(vertices)));
+		vertexBuffer->SetLayout({
+			{ShaderDataType::Float2, "a_Position"},
+			});
+
+		std::shared_ptr<IndexBuffer> indexBuffer;
+		indexBuffer.reset(IndexBuffer::Create(indices, 3));
+
+		s_Data->FullscreenTriangle = VertexArray::Create();
+		s_Data->FullscreenTriangle->AddVertexBuffer(vertexBuffer);
+		s_Data->FullscreenTriangle->SetIndexBuffer(indexBuffer);
+	}
+
+	void PostProcessing::Shutdown() {
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	PostProcessing::Settings& PostProcessing::GetSettings() {
+		return s_Data->Settings;
+	}
+
+	//Every effect writes opaque texels, so premultiplied blending just replaces the target
+	static void DrawFullscreen(const Ref<Framebuffer>& target) {
+		target->Bind();
+		s_Data->FullscreenTriangle->Bind();
+		RenderCommand::SetBlendMode(RendererAPI::BlendMode::PremultipliedAlpha);
+		RenderCommand::DrawIndexed(s_Data->FullscreenTriangle);
+		RenderCommand::SetBlendMode(RendererAPI::BlendMode::Alpha);
+	}
+
+	static void BindSource(const Ref<Shader>& shader, const std::string& name, int slot, const Ref<Framebuffer>& source) {
+		shader->SetInt(name, slot);
+		RenderCommand::BindTextureID(slot, source->GetColorAttachmentRendererID());
+	}
+
+	//Size of one used texel in the texture coordinates of a possibly over-allocated attachment
+	static glm::vec2 GetTexelSize(const Ref<Framebuffer>& framebuffer) {
+		const FramebufferSpecification& spec = framebuffer->GetSpecification();
+		return framebuffer->GetUVScale() / glm::vec2((float)spec.Width, (float)spec.Height);
+	}
+
+	static void DrawPrefilter(const Ref<Framebuffer>& source, const Ref<Framebuffer>& target) {
+		const Ref<Shader>& shader = s_Data->Prefilter;
+		shader->Bind();
+		BindSource(shader, "u_Source", 0, source);
+		shader->SetFloat2("u_UVScale", source->GetUVScale());
+		shader->SetFloat2("u_TexelSize", GetTexelSize(source));
+		shader->SetFloat("u_Threshold", s_Data->Settings.BloomThreshold);
+		DrawFullscreen(target);
+	}
+
+	static void DrawBlur(const Ref<Framebuffer>& source, const Ref<Framebuffer>& target, bool horizontal) {
+		const Ref<Shader>& shader = s_Data->Blur;
+		glm::vec2 texelSize = GetTexelSize(source);
+		shader->Bind();
+		BindSource(shader, "u_Source", 0, source);
+		shader->SetFloat2("u_UVScale", source->GetUVScale());
+		shader->SetFloat2("u_TexelSize", texelSize);
+		shader->SetFloat2("u_Direction", horizontal ? glm::vec2(texelSize.x, 0.0f) : glm::vec2(0.0f, texelSize.y));
+		DrawFullscreen(target);
+	}
+
+	static void DrawComposite(const Ref<Framebuffer>& source, const Ref<Framebuffer>& bloom, const Ref<Framebuffer>& target) {
+		const PostProcessing::Settings& settings = s_Data->Settings;
+		const Ref<Shader>& shader = s_Data->Composite;
+		shader->Bind();
+		BindSource(shader, "u_Source", 0, source);
+		shader->SetFloat2("u_UVScale", source->GetUVScale());
+
+		//Sharpening only makes up for the detail lost to a smaller source
+		const FramebufferSpecification& sourceSpec = source->GetSpecification();
+		const FramebufferSpecification& targetSpec = target->GetSpecification();
+		bool upscaled = sourceSpec.Width < targetSpec.Width || sourceSpec.Height < targetSpec.Height;
+		shader->SetFloat("u_Sharpness", upscaled ? glm::clamp(DynamicResolution::GetSettings().Sharpness, 0.0f, 1.0f) : 0.0f);
+		shader->SetFloat2("u_SourceTexelSize", GetTexelSize(source));
+
+		shader->SetInt("u_Bloom", bloom ? 1 : 0);
+		if (bloom) {
+			BindSource(shader, "u_BloomTexture", 1, bloom);
+			shader->SetFloat2("u_BloomUVScale", bloom->GetUVScale());
+			shader->SetFloat("u_BloomIntensity", settings.BloomIntensity);
+		}
+
+		bool grading = settings.ColorGrading && settings.Lut;
+		shader->SetInt("u_ColorGrading", grading ? 1 : 0);
+		if (grading) {
+			shader->SetInt("u_Lut", 2);
+			settings.Lut->Bind(2);
+			shader->SetFloat("u_LutSize", (float)settings.Lut->GetHeight());
+			shader->SetFloat("u_LutContribution", settings.LutContribution);
+		}
+
+		shader->SetInt("u_Vignette", settings.Vignette ? 1 : 0);
+		shader->SetFloat("u_VignetteIntensity", settings.VignetteIntensity);
+		shader->SetFloat("u_VignetteSmoothness", settings.VignetteSmoothness);
+
+		shader->SetInt("u_CRT", settings.CRT ? 1 : 0);
+		shader->SetFloat("u_CRTCurvature", settings.CRTCurvature);
+		shader->SetFloat("u_ScanlineIntensity", settings.ScanlineIntensity);
+		shader->SetFloat("u_ScanlineCount", (float)target->GetSpecification().Height);
+		DrawFullscreen(target);
+	}
+
+	RenderGraph::Resource PostProcessing::AddPasses(RenderGraph& graph, RenderGraph::Resource source, const glm::uvec2& outputSize) {
+		const Settings& settings = s_Data->Settings;
+		const Ref<Framebuffer>& sourceTarget = graph.GetFramebuffer(source);
+		if (!s_Data->Composite || !sourceTarget)
+			return source;
+
+		const FramebufferSpecification& sourceSpec = sourceTarget->GetSpecification();
+		bool upscale = sourceSpec.Width != outputSize.x || sourceSpec.Height != outputSize.y;
+		if (!settings.IsAnyEnabled() && !upscale)
+			return source;
+
+		if (!s_Data->Output) {
+			FramebufferSpecification spec;
+			spec.Attachments = { FramebufferTextureFormat::RGBA8 };
+			spec.Width = outputSize.x;
+			spec.Height = outputSize.y;
+			s_Data->Output = Framebuffer::Create(spec);
+		}
+		else if (s_Data->Output->GetSpecification().Width != outputSize.x || s_Data->Output->GetSpecification().Height != outputSize.y) {
+			s_Data->Output->Resize(outputSize.x, outputSize.y);
+		}
+		RenderGraph::Resource output = graph.Import("Post Output", s_Data->Output);
+
+		bool bloom = settings.Bloom;
+		RenderGraph::Resource bloomPing = 0;
+		if (bloom) {
+			float resolution = glm::clamp(settings.BloomResolution, 0.1f, 1.0f);
+			FramebufferSpecification spec;
+			spec.Attachments = { FramebufferTextureFormat::RGBA8 };
+			spec.Width = std::max((uint32_t)(sourceSpec.Width * resolution), 1u);
+			spec.Height = std::max((uint32_t)(sourceSpec.Height * resolution), 1u);
+			bloomPing = graph.CreateTransient("Bloom Ping", spec);
+			RenderGraph::Resource bloomPong = graph.CreateTransient("Bloom Pong", spec);
+
+			graph.AddPass("Bloom Prefilter",
+				[&](RenderGraph::PassBuilder& builder) { builder.Read(source); builder.Write(bloomPing); },
+				[source, bloomPing](RenderGraph& rg) { DrawPrefilter(rg.GetFramebuffer(source), rg.GetFramebuffer(bloomPing)); });
+			for (int i = 0; i < std::max(settings.BloomIterations, 1); i++) {
+				graph.AddPass("Bloom Blur",
+					[&](RenderGraph::PassBuilder& builder) { builder.Read(bloomPing); builder.Write(bloomPong); },
+					[bloomPing, bloomPong](RenderGraph& rg) { DrawBlur(rg.GetFramebuffer(bloomPing), rg.GetFramebuffer(bloomPong), true); });
+				graph.AddPass("Bloom Blur",
+					[&](RenderGraph::PassBuilder& builder) { builder.Read(bloomPong); builder.Write(bloomPing); },
+					[bloomPing, bloomPong](RenderGraph& rg) { DrawBlur(rg.GetFramebuffer(bloomPong), rg.GetFramebuffer(bloomPing), false); });
+			}
+		}
+
+		graph.AddPass("Post Composite",
+			[&](RenderGraph::PassBuilder& builder) {
+				builder.Read(source);
+				if (bloom)
+					builder.Read(bloomPing);
+				builder.Write(output);
+			},
+			[source, bloom, bloomPing, output](RenderGraph& rg) {
+				DrawComposite(rg.GetFramebuffer(source), bloom ? rg.GetFramebuffer(bloomPing) : nullptr, rg.GetFramebuffer(output));
+			});
+		return output;
+	}
+}
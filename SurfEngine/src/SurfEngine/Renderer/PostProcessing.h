@@ -0,0 +1,50 @@
+#pragma once
+#include "RenderGraph.h"
+#include "Texture.h"
+#include <glm/glm.hpp>
+
+namespace SurfEngine {
+
+	// Screen effects applied to the scene color before it is shown, also the upscale of a scaled down scene
+	// Bloom blurs a thresholded copy in two reduced resolution buffers that ping-pong between the blur
+	// directions, everything else happens in one composite over a shared fullscreen triangle
+	// Disabled effects add no passes, and with every effect off the graph is left untouched
+	class PostProcessing {
+	public:
+		struct Settings {
+			bool Bloom = false;
+			float BloomThreshold = 0.8f;
+			float BloomIntensity = 1.0f;
+			// Size of the bloom buffers relative to the output
+			float BloomResolution = 0.5f;
+			// Horizontal and vertical blur pairs, each one widens the glow
+			int BloomIterations = 2;
+
+			// Strip of size x size cells with red across a cell, green down it and blue across the cells
+			bool ColorGrading = false;
+			std::string Lut_Path = "";
+			Ref<Texture2D> Lut;
+			float LutContribution = 1.0f;
+
+			bool Vignette = false;
+			float VignetteIntensity = 0.4f;
+			float VignetteSmoothness = 0.5f;
+
+			bool CRT = false;
+			float CRTCurvature = 0.1f;
+			float ScanlineIntensity = 0.25f;
+
+			bool IsAnyEnabled() const { return Bloom || (ColorGrading && Lut) || Vignette || CRT; }
+		};
+	public:
+		static void Init();
+		static void Shutdown();
+
+		static Settings& GetSettings();
+
+		// Adds the passes of the enabled effects reading source and returns the resource holding the final image
+		// A source smaller than outputSize is upscaled with DynamicResolution's sharpening in the same composite
+		// Returns source itself when there is nothing to do or the backend has no post processing shaders
+		static RenderGraph::Resource AddPasses(RenderGraph& graph, RenderGraph::Resource source, const glm::uvec2& outputSize);
+	};
+}
@@ -1,8 +1,11 @@
 #include "sepch.h"
 #include "RenderCommand.h"
 
-#include "SurfEngine/Platform/OpenGl/OpenGLRendererAPI.h"
-
 namespace SurfEngine {
-	 RendererAPI* RenderCommand::s_RendererAPI = new OpenGLRendererAPI;
+	RendererAPI* RenderCommand::s_RendererAPI = nullptr;
+
+	void RenderCommand::Init() {
+		delete s_RendererAPI;
+		s_RendererAPI = RendererAPI::Create();
+	}
 }
\ No newline at end of file
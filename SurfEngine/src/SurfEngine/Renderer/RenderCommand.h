@@ -4,16 +4,24 @@ namespace SurfEngine {
 	class RenderCommand
 	{
 	public:
+		static void Init();
+
 		inline static void SetClearColor(const glm::vec4 color) { s_RendererAPI->SetClearColor(color); }
 		inline static void Clear() { s_RendererAPI->Clear(); }
 		inline static void EnableTextures() { s_RendererAPI->EnableTextures(); }
 		inline static void EnableMSAA() { s_RendererAPI->EnableMSAA(); }
 		inline static void EnableDepthTesting() { s_RendererAPI->EnableDepth(); }
+		inline static void SetDepthMode(RendererAPI::DepthMode mode) { s_RendererAPI->SetDepthMode(mode); }
 		inline static void EnableBlending() { s_RendererAPI->EnableBlending(); }
+		inline static void SetBlendMode(RendererAPI::BlendMode mode) { s_RendererAPI->SetBlendMode(mode); }
 		inline static void BindTextureID(int slot, std::uint32_t id) { s_RendererAPI->BindTextureId(slot,id); }
 		inline static void SetWireFrameMode(RendererAPI::WireFrameMode mode) { s_RendererAPI->SetWireFrameMode(mode); }
-		inline static void DrawIndexed(const Ref<VertexArray>& vertexArray) { s_RendererAPI->DrawIndexed(vertexArray); }
+		inline static void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0) { s_RendererAPI->DrawIndexed(vertexArray, indexCount); }
+		inline static void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t instanceCount) { s_RendererAPI->DrawIndexedInstanced(vertexArray, instanceCount); }
 		inline static void DrawLine(const Ref<VertexArray>& vertexArray) { s_RendererAPI->DrawLine(vertexArray); }
+		inline static void BeginGPUTimer() { s_RendererAPI->BeginGPUTimer(); }
+		inline static void EndGPUTimer() { s_RendererAPI->EndGPUTimer(); }
+		inline static float GetGPUTime() { return s_RendererAPI->GetGPUTime(); }
 	private:
 		static RendererAPI* s_RendererAPI;
 	};
@@ -0,0 +1,232 @@
+#include "sepch.h"
+#include "RenderGraph.h"
+#include "RenderTargetPool.h"
+
+#include <set>
+
+namespace SurfEngine {
+
+	RenderGraph::Resource RenderGraph::PassBuilder::Read(Resource resource) {
+		SE_CORE_ASSERT(resource < m_Graph.m_Resources.size(), "Unknown render graph resource!");
+		m_Graph.m_Passes[m_Pass].Reads.push_back(resource);
+		return resource;
+	}
+
+	RenderGraph::Resource RenderGraph::PassBuilder::Write(Resource resource) {
+		SE_CORE_ASSERT(resource < m_Graph.m_Resources.size(), "Unknown render graph resource!");
+		m_Graph.m_Passes[m_Pass].Writes.push_back(resource);
+		return resource;
+	}
+
+	void RenderGraph::Reset() {
+		m_Resources.clear();
+		m_Passes.clear();
+		m_Order.clear();
+		m_Compiled = false;
+		m_Stats = Statistics();
+	}
+
+	RenderGraph::Resource RenderGraph::Import(const std::string& name, const Ref<Framebuffer>& framebuffer) {
+		ResourceNode node;
+		node.Name = name;
+		node.Target = framebuffer;
+		node.Imported = true;
+		if (framebuffer)
+			node.Spec = framebuffer->GetSpecification();
+		m_Resources.push_back(node);
+		return (Resource)m_Resources.size() - 1;
+	}
+
+	RenderGraph::Resource RenderGraph::CreateTransient(const std::string& name, const FramebufferSpecification& spec) {
+		ResourceNode node;
+		node.Name = name;
+		node.Spec = spec;
+		m_Resources.push_back(node);
+		return (Resource)m_Resources.size() - 1;
+	}
+
+	void RenderGraph::MarkOutput(Resource resource) {
+		SE_CORE_ASSERT(resource < m_Resources.size(), "Unknown render graph resource!");
+		m_Resources[resource].Output = true;
+	}
+
+	void RenderGraph::AddPass(const std::string& name, const std::function<void(PassBuilder&)>& setup, const std::function<void(RenderGraph&)>& execute) {
+		PassNode pass;
+		pass.Name = name;
+		pass.Execute = execute;
+		m_Passes.push_back(pass);
+
+		PassBuilder builder(*this, (uint32_t)m_Passes.size() - 1);
+		setup(builder);
+		m_Compiled = false;
+	}
+
+	bool RenderGraph::Compile() {
+		const uint32_t passCount = (uint32_t)m_Passes.size();
+		for (auto& pass : m_Passes) {
+			pass.Dependencies.clear();
+			pass.OrderAfter.clear();
+			pass.Culled = true;
+		}
+		m_Order.clear();
+		m_Compiled = false;
+
+		//Walk the passes in declaration order tracking the latest write of every resource
+		//Reads of a resource nothing has written yet wait for every later writer instead
+		std::vector<int> lastWriter(m_Resources.size(), -1);
+		std::vector<std::vector<uint32_t>> readersSinceWrite(m_Resources.size());
+		std::vector<std::vector<uint32_t>> earlyReaders(m_Resources.size());
+		std::vector<std::vector<uint32_t>> writers(m_Resources.size());
+		for (uint32_t i = 0; i < passCount; i++) {
+			PassNode& pass = m_Passes[i];
+			for (Resource resource : pass.Reads) {
+				if (lastWriter[resource] >= 0) {
+					pass.Dependencies.push_back((uint32_t)lastWriter[resource]);
+					readersSinceWrite[resource].push_back(i);
+				}
+				else {
+					earlyReaders[resource].push_back(i);
+				}
+			}
+			for (Resource resource : pass.Writes) {
+				if (lastWriter[resource] >= 0 && lastWriter[resource] != (int)i)
+					pass.Dependencies.push_back((uint32_t)lastWriter[resource]);
+				//Whoever read the previous contents has to be done with them first
+				for (uint32_t reader : readersSinceWrite[resource]) {
+					if (reader != i)
+						pass.OrderAfter.push_back(reader);
+				}
+				readersSinceWrite[resource].clear();
+				lastWriter[resource] = (int)i;
+				writers[resource].push_back(i);
+			}
+		}
+		for (Resource resource = 0; resource < (Resource)m_Resources.size(); resource++) {
+			for (uint32_t reader : earlyReaders[resource]) {
+				for (uint32_t writer : writers[resource]) {
+					if (writer != reader)
+						m_Passes[reader].Dependencies.push_back(writer);
+				}
+			}
+		}
+
+		//Keep the passes that write an output and everything they depend on
+		std::vector<uint32_t> stack;
+		for (uint32_t i = 0; i < passCount; i++) {
+			for (Resource resource : m_Passes[i].Writes) {
+				if (m_Resources[resource].Output) {
+					stack.push_back(i);
+					break;
+				}
+			}
+		}
+		while (!stack.empty()) {
+			uint32_t index = stack.back();
+			stack.pop_back();
+			if (!m_Passes[index].Culled)
+				continue;
+			m_Passes[index].Culled = false;
+			for (uint32_t dependency : m_Passes[index].Dependencies)
+				stack.push_back(dependency);
+		}
+
+		//Topological order, the earliest declared ready pass goes first
+		std::vector<std::vector<uint32_t>> dependents(passCount);
+		std::vector<uint32_t> pending(passCount, 0);
+		for (uint32_t i = 0; i < passCount; i++) {
+			if (m_Passes[i].Culled)
+				continue;
+			std::vector<uint32_t> before = m_Passes[i].Dependencies;
+			before.insert(before.end(), m_Passes[i].OrderAfter.begin(), m_Passes[i].OrderAfter.end());
+			std::sort(before.begin(), before.end());
+			before.erase(std::unique(before.begin(), before.end()), before.end());
+			for (uint32_t dependency : before) {
+				if (m_Passes[dependency].Culled)
+					continue;
+				dependents[dependency].push_back(i);
+				pending[i]++;
+			}
+		}
+
+		std::set<uint32_t> ready;
+		uint32_t keptCount = 0;
+		for (uint32_t i = 0; i < passCount; i++) {
+			if (m_Passes[i].Culled)
+				continue;
+			keptCount++;
+			if (pending[i] == 0)
+				ready.insert(i);
+		}
+		while (!ready.empty()) {
+			uint32_t index = *ready.begin();
+			ready.erase(ready.begin());
+			m_Order.push_back(index);
+			for (uint32_t dependent : dependents[index]) {
+				if (--pending[dependent] == 0)
+					ready.insert(dependent);
+			}
+		}
+
+		if (m_Order.size() != keptCount) {
+			SE_CORE_ERROR("Render graph has a dependency cycle, nothing will be drawn");
+			m_Order.clear();
+			return false;
+		}
+
+		//Lifetimes in execution order
+		for (auto& resource : m_Resources)
+			resource.FirstUse = resource.LastUse = -1;
+		for (int position = 0; position < (int)m_Order.size(); position++) {
+			const PassNode& pass = m_Passes[m_Order[position]];
+			for (const auto* list : { &pass.Reads, &pass.Writes }) {
+				for (Resource resource : *list) {
+					ResourceNode& node = m_Resources[resource];
+					if (node.FirstUse < 0)
+						node.FirstUse = position;
+					node.LastUse = position;
+				}
+			}
+		}
+
+		m_Stats = Statistics();
+		m_Stats.Passes = keptCount;
+		m_Stats.CulledPasses = passCount - keptCount;
+		for (const auto& resource : m_Resources) {
+			if (!resource.Imported && resource.FirstUse >= 0)
+				m_Stats.Transients++;
+		}
+		m_Compiled = true;
+		return true;
+	}
+
+	void RenderGraph::Execute() {
+		if (!m_Compiled && !Compile())
+			return;
+
+		std::set<const Framebuffer*> transientTargets;
+		for (int position = 0; position < (int)m_Order.size(); position++) {
+			for (auto& resource : m_Resources) {
+				if (!resource.Imported && resource.FirstUse == position) {
+					resource.Target = RenderTargetPool::AcquireTransient(resource.Spec);
+					transientTargets.insert(resource.Target.get());
+				}
+			}
+
+			PassNode& pass = m_Passes[m_Order[position]];
+			pass.Execute(*this);
+
+			for (auto& resource : m_Resources) {
+				if (!resource.Imported && resource.LastUse == position) {
+					RenderTargetPool::Release(resource.Target);
+					resource.Target = nullptr;
+				}
+			}
+		}
+		m_Stats.TransientTargets = (uint32_t)transientTargets.size();
+	}
+
+	const Ref<Framebuffer>& RenderGraph::GetFramebuffer(Resource resource) const {
+		SE_CORE_ASSERT(resource < m_Resources.size(), "Unknown render graph resource!");
+		return m_Resources[resource].Target;
+	}
+}
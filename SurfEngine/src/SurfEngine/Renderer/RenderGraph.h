@@ -0,0 +1,81 @@
+#pragma once
+#include "FrameBuffer.h"
+#include <functional>
+
+namespace SurfEngine {
+
+	// Render passes over framebuffer resources, rebuilt every frame
+	// Passes declare the resources they read and write. Compile drops the passes no output depends on,
+	// orders the rest so every pass runs after the writes it reads and finds the first and last use of
+	// every transient. Transients come from the RenderTargetPool at their first use and go back after
+	// their last, so transients whose lifetimes do not overlap end up sharing a framebuffer
+	class RenderGraph {
+	public:
+		using Resource = uint32_t;
+
+		struct Statistics {
+			uint32_t Passes = 0;
+			uint32_t CulledPasses = 0;
+			uint32_t Transients = 0;
+			// Framebuffers the transients were actually placed in
+			uint32_t TransientTargets = 0;
+		};
+
+		class PassBuilder {
+		public:
+			// Drawing adds to a target, so a write also depends on the writes declared before it
+			Resource Read(Resource resource);
+			Resource Write(Resource resource);
+		private:
+			PassBuilder(RenderGraph& graph, uint32_t pass)
+				: m_Graph(graph), m_Pass(pass) {}
+
+			RenderGraph& m_Graph;
+			uint32_t m_Pass;
+			friend class RenderGraph;
+		};
+	public:
+		void Reset();
+
+		Resource Import(const std::string& name, const Ref<Framebuffer>& framebuffer);
+		Resource CreateTransient(const std::string& name, const FramebufferSpecification& spec);
+		// Outputs and every pass they depend on survive culling, only imported resources outlive Execute
+		void MarkOutput(Resource resource);
+
+		// Passes without a dependency between them run in the order they were added
+		void AddPass(const std::string& name, const std::function<void(PassBuilder&)>& setup, const std::function<void(RenderGraph&)>& execute);
+
+		// Returns false and leaves the graph unexecutable if the dependencies form a cycle
+		bool Compile();
+		void Execute();
+
+		// Transients only have a framebuffer while a pass using them executes
+		const Ref<Framebuffer>& GetFramebuffer(Resource resource) const;
+		const std::string& GetName(Resource resource) const { return m_Resources[resource].Name; }
+		const Statistics& GetStats() const { return m_Stats; }
+	private:
+		struct ResourceNode {
+			std::string Name;
+			FramebufferSpecification Spec;
+			Ref<Framebuffer> Target;
+			bool Imported = false;
+			bool Output = false;
+			int FirstUse = -1, LastUse = -1;
+		};
+
+		struct PassNode {
+			std::string Name;
+			std::vector<Resource> Reads, Writes;
+			std::function<void(RenderGraph&)> Execute;
+			// Passes whose results this one uses, then passes that have to run first for any other reason
+			std::vector<uint32_t> Dependencies, OrderAfter;
+			bool Culled = false;
+		};
+
+		std::vector<ResourceNode> m_Resources;
+		std::vector<PassNode> m_Passes;
+		std::vector<uint32_t> m_Order;
+		bool m_Compiled = false;
+		Statistics m_Stats;
+	};
+}
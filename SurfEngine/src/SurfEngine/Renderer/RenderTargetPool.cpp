@@ -0,0 +1,115 @@
+#include "sepch.h"
+#include "RenderTargetPool.h"
+
+namespace SurfEngine {
+
+	// Frames a pooled framebuffer can sit unused before it is released
+	static const uint64_t s_EvictAfterFrames = 120;
+
+	struct PooledTarget {
+		Ref<Framebuffer> Target;
+		uint64_t LastUsedFrame = 0;
+		bool InUse = false;
+	};
+
+	struct RenderTargetPoolData {
+		std::vector<PooledTarget> Targets;
+		uint64_t Frame = 0;
+		RenderTargetPool::Statistics Stats;
+	};
+
+	static RenderTargetPoolData* s_Data = nullptr;
+
+	static bool IsCompatible(const FramebufferSpecification& a, const FramebufferSpecification& b) {
+		if (a.Samples != b.Samples || a.SwapChainTarget != b.SwapChainTarget)
+			return false;
+
+		const auto& attachmentsA = a.Attachments.Attachments;
+		const auto& attachmentsB = b.Attachments.Attachments;
+		if (attachmentsA.size() != attachmentsB.size())
+			return false;
+
+		for (size_t i = 0; i < attachmentsA.size(); i++) {
+			if (attachmentsA[i].TextureFormat != attachmentsB[i].TextureFormat)
+				return false;
+		}
+		return true;
+	}
+
+	void RenderTargetPool::Init() {
+		s_Data = new RenderTargetPoolData();
+	}
+
+	void RenderTargetPool::Shutdown() {
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	Ref<Framebuffer> RenderTargetPool::AcquireTransient(const FramebufferSpecification& spec) {
+		//Prefer an exact size match, otherwise the closest compatible target
+		PooledTarget* best = nullptr;
+		uint64_t bestDifference = UINT64_MAX;
+		for (auto& pooled : s_Data->Targets) {
+			if (pooled.InUse || !IsCompatible(pooled.Target->GetSpecification(), spec))
+				continue;
+
+			const auto& current = pooled.Target->GetSpecification();
+			uint64_t difference = (uint64_t)std::abs((int64_t)current.Width - spec.Width) + (uint64_t)std::abs((int64_t)current.Height - spec.Height);
+			if (difference < bestDifference) {
+				best = &pooled;
+				bestDifference = difference;
+				if (difference == 0)
+					break;
+			}
+		}
+
+		if (best) {
+			//Framebuffers absorb small resizes without reallocating
+			if (bestDifference != 0)
+				best->Target->Resize(spec.Width, spec.Height);
+			s_Data->Stats.Reuses++;
+		}
+		else {
+			s_Data->Targets.push_back({ Framebuffer::Create(spec) });
+			best = &s_Data->Targets.back();
+			s_Data->Stats.Allocations++;
+		}
+
+		best->InUse = true;
+		best->LastUsedFrame = s_Data->Frame;
+		s_Data->Stats.InUse++;
+		s_Data->Stats.Pooled = (uint32_t)s_Data->Targets.size();
+		return best->Target;
+	}
+
+	void RenderTargetPool::Release(const Ref<Framebuffer>& framebuffer) {
+		for (auto& pooled : s_Data->Targets) {
+			if (pooled.Target == framebuffer && pooled.InUse) {
+				pooled.InUse = false;
+				s_Data->Stats.InUse--;
+				return;
+			}
+		}
+	}
+
+	void RenderTargetPool::EndFrame() {
+		if (!s_Data)
+			return;
+
+		s_Data->Frame++;
+		for (auto& pooled : s_Data->Targets)
+			pooled.InUse = false;
+
+		auto expired = [](const PooledTarget& pooled) {
+			return s_Data->Frame - pooled.LastUsedFrame > s_EvictAfterFrames;
+		};
+		s_Data->Targets.erase(std::remove_if(s_Data->Targets.begin(), s_Data->Targets.end(), expired), s_Data->Targets.end());
+
+		s_Data->Stats.InUse = 0;
+		s_Data->Stats.Pooled = (uint32_t)s_Data->Targets.size();
+	}
+
+	const RenderTargetPool::Statistics& RenderTargetPool::GetStats() {
+		return s_Data->Stats;
+	}
+}
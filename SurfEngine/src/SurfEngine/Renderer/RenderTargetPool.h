@@ -0,0 +1,28 @@
+#pragma once
+#include "FrameBuffer.h"
+
+namespace SurfEngine {
+
+	// Hands out scratch framebuffers so render features do not allocate their own
+	// Transient targets stay reserved until EndFrame and are then reused by later requests
+	// with the same attachment formats, targets left unused for a while are released
+	class RenderTargetPool {
+	public:
+		struct Statistics {
+			uint32_t Allocations = 0;
+			uint32_t Reuses = 0;
+			uint32_t Pooled = 0;
+			uint32_t InUse = 0;
+		};
+	public:
+		static void Init();
+		static void Shutdown();
+
+		static Ref<Framebuffer> AcquireTransient(const FramebufferSpecification& spec);
+		// Hands a transient back before the end of the frame so later passes can alias it
+		static void Release(const Ref<Framebuffer>& framebuffer);
+		static void EndFrame();
+
+		static const Statistics& GetStats();
+	};
+}
@@ -1,7 +1,6 @@
 #include "sepch.h"
 #include "Renderer.h"
 #include "Camera.h"
-#include "SurfEngine/Platform/OpenGl/OpenGLShader.h"
 
 namespace SurfEngine {
 
@@ -17,8 +16,8 @@ namespace SurfEngine {
 
 	void Renderer::Submit(const Ref<Shader> shader, const Ref<VertexArray>& vertexArray, const glm::mat4& transform){
 		shader->Bind();
-		std::dynamic_pointer_cast<OpenGLShader>(shader)->UploadUniformMat4("u_ViewProjection",m_SceneData->ViewProjectionMatrix);
-		std::dynamic_pointer_cast<OpenGLShader>(shader)->UploadUniformMat4("u_Transform", transform);
+		shader->SetMat4("u_ViewProjection", m_SceneData->ViewProjectionMatrix);
+		shader->SetMat4("u_Transform", transform);
 		vertexArray->Bind();
 		RenderCommand::DrawIndexed(vertexArray);
 	}
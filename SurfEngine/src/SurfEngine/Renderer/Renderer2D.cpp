@@ -5,25 +5,136 @@
 #include "SurfEngine/Renderer/Material.h"
 #include "SurfEngine/Platform/OpenGl/OpenGLShader.h"
 #include "SurfEngine/Renderer/RenderCommand.h"
+#include "SurfEngine/Renderer/RenderTargetPool.h"
+#include "SurfEngine/Renderer/PostProcessing.h"
+#include "SurfEngine/Renderer/DynamicResolution.h"
+#include "SurfEngine/Renderer/SpriteMesh.h"
 #include "glm/gtx/rotate_vector.hpp"
 #include "glm/gtc/matrix_transform.hpp"
 
+#include <cfloat>
+
 namespace SurfEngine{
 
 
+	static const uint32_t s_StaticTileSize = 512;
+	static const uint32_t s_MaxStaticTilesPerLayer = 64;
+	static const uint64_t s_StaticTileLifetime = 300;
+
+	// Lights are binned into square screen tiles of this many pixels
+	static const uint32_t s_LightTileSize = 32;
+	static const uint32_t s_MaxLights = 1024;
+	// Light data texels per light, see SubmitLight
+	static const uint32_t s_LightTexels = 3;
+	// Width of the light index texture, each texel holds four indices
+	static const uint32_t s_LightIndexWidth = 1024;
+	// Texture units the lighting inputs of the sprite shader are bound to, unit 0 is the sprite itself
+	static const uint32_t s_NormalMapSlot = 1;
+	static const uint32_t s_LightDataSlot = 2;
+	static const uint32_t s_LightTilesSlot = 3;
+	static const uint32_t s_LightIndicesSlot = 4;
+
+	struct StaticLayerTile {
+		Ref<Framebuffer> Target;
+		uint64_t LastUsedFrame = 0;
+	};
+
+	struct StaticLayerCache {
+		size_t ContentHash = 0;
+		float PixelsPerUnit = 0.0f;
+		uint64_t LastUsedFrame = 0;
+		std::unordered_map<uint64_t, StaticLayerTile> Tiles;
+	};
+
+	// Outline meshes built for one texture, keyed by frame count and vertex budget, null entries draw the quad
+	struct SpriteMeshCache {
+		std::weak_ptr<Texture2D> Texture;
+		std::unordered_map<uint64_t, Ref<SpriteMesh>> Meshes;
+	};
+
+	// Slot of the sprite texture table, the texture stays loaded while any sprite holds its handle
+	struct TextureSlot {
+		Ref<Texture2D> Texture;
+		uint32_t References = 0;
+	};
+
+	// Glyph quads of one string in em units, 8 floats each: plane min, plane max, uv min, uv max
+	struct TextLayout {
+		std::weak_ptr<Font> FontRef;
+		std::string Text;
+		float Kerning = 0.0f, LineSpacing = 1.0f;
+		std::vector<float> Quads;
+		uint64_t LastUsedFrame = 0;
+	};
+
+	// Glyphs queued for one font atlas, x, y, z, texX, texY, r, g, b, a per vertex
+	struct TextBatch {
+		Ref<Font> FontRef;
+		std::vector<float> Vertices;
+	};
+
+	// Float textures the sprite shader reads its lights from, rebuilt by EndLighting every frame
+	struct LightingStorage {
+		bool Enabled = false;
+		glm::vec3 Ambient = glm::vec3(1.0f);
+		// s_LightTexels texels per light and the world space circle each one reaches
+		std::vector<glm::vec4> LightTexels;
+		std::vector<glm::vec3> Bounds;
+		Ref<Texture2D> LightData;
+		// (first index, light count) per tile, the indices of all tiles packed in one list
+		Ref<Texture2D> Tiles;
+		Ref<Texture2D> Indices;
+		glm::uvec2 TileCount = glm::uvec2(0);
+		uint32_t IndexRows = 0;
+		std::vector<glm::vec4> TileTexels;
+		std::vector<uint32_t> TileOffsets;
+		std::vector<float> IndexList;
+		std::vector<glm::ivec4> LightRects;
+	};
+
 	struct Renderer2DStorage {
 			std::unordered_map<std::string, Ref<Material>> MaterialCache;
+			Ref<VertexArray> QuadVertexArray;
+			Ref<VertexArray> TextVertexArray;
+			Ref<VertexBuffer> TextVertexBuffer;
 			Ref<VertexArray> VertexArray;
 			Ref<Framebuffer> RenderTarget;
+			Ref<Framebuffer> Output;
+			glm::uvec2 OutputSize = glm::uvec2(0);
 			Ref<Texture2D> CameraGizmo;
+			Ref<Texture2D> WhiteTexture;
 			glm::vec4 GizmoColorActive = glm::vec4(1.0f,0.5f,0.0f,1.0f);
 			glm::vec4 GizmoColorInActive = glm::vec4(1.0f, 1.0, 1.0f, 0.3f);
+
+			glm::mat4 ViewProjection = glm::mat4(1.0f);
+			glm::mat4 Projection = glm::mat4(1.0f);
+			uint64_t FrameIndex = 0;
+			Renderer2D::SpritePass SpritePass = Renderer2D::SpritePass::Painter;
+			std::unordered_map<const Texture2D*, SpriteMeshCache> SpriteMeshes;
+			// Slot 0 is the null handle
+			std::vector<TextureSlot> TextureSlots = std::vector<TextureSlot>(1);
+			std::vector<uint32_t> FreeTextureSlots;
+			std::unordered_map<const Texture2D*, uint32_t> TextureHandles;
+			Renderer2D::Statistics Stats;
+			std::unordered_map<unsigned int, StaticLayerCache> StaticLayers;
+			std::vector<Ref<Framebuffer>> FreeStaticTiles;
+
+			Ref<Font> DefaultFont;
+			std::unordered_map<std::string, std::weak_ptr<Font>> Fonts;
+			std::unordered_map<size_t, TextLayout> TextLayouts;
+			std::vector<TextBatch> TextBatches;
+			uint32_t TextGlyphCapacity = 0;
+
+			LightingStorage Lighting;
 	};
 
 	static Renderer2DStorage* s_Data;
 
 	void Renderer2D::Init() {
 		s_Data = new Renderer2DStorage();
+		RenderTargetPool::Init();
+		PostProcessing::Init();
+		DynamicResolution::Init();
 
 		//Add Mandatory Shaders
 		PushMaterial("SurfMaterial_BackgrounGridShader", Shader::Create("res/shaders/background_grid_2d.glsl"));
@@ -36,19 +147,120 @@ namespace SurfEngine{
 
 		PushMaterial("SurfMaterial_Gizmo", Shader::Create("res/shaders/gizmo.glsl"));
 
+		PushMaterial("SurfMaterial_Particle", Shader::Create("res/shaders/particle.glsl"));
+
+		PushMaterial("SurfMaterial_Text", Shader::Create("res/shaders/text.glsl"));
+
 		s_Data->CameraGizmo = Texture2D::Create("res/gizmos/camera.png");
+		s_Data->DefaultFont = GetFont("res/OpenSans-VariableFont.ttf");
+
+		//Untextured sprites go through the sprite shader while lighting is on
+		uint32_t white = 0xFFFFFFFFu;
+		s_Data->WhiteTexture = Texture2D::Create(1, 1);
+		s_Data->WhiteTexture->SetData(&white, sizeof(uint32_t));
+
+		s_Data->Lighting.LightData = Texture2D::Create(s_LightTexels, s_MaxLights, Texture2D::Format::RGBA32F);
+		s_Data->Lighting.LightTexels.reserve((size_t)s_LightTexels * s_MaxLights);
+
+		//Shared unit quad, sprites, colors and circles only differ in uniforms
+		float SquareVertices[5 * 4] = {
+			0.5f, 0.5f, 0.0f, 1.0f, 0.0f, // top right
+		   -0.5f, 0.5f, 0.0f, 0.0f, 0.0f, // top left
+		   -0.5f, -0.5f, 0.0f, 0.0f, 1.0f, // bottom left
+			0.5f, -0.5f, 0.0f, 1.0f, 1.0f, //bottom right
+		};
+		uint32_t squareindices[6] = { 0, 1, 2, 2, 3, 0 };
+
+		Ref<VertexBuffer> squareVB;
+		squareVB.reset(VertexBuffer::Create(SquareVertices, sizeof(SquareVertices)));
+		squareVB->SetLayout({
+			{ShaderDataType::Float3, "a_Position"},
+			{ShaderDataType::Float2, "a_TexCoord"},
+			});
+
+		std::shared_ptr<IndexBuffer> squareIB;
+		squareIB.reset(IndexBuffer::Create(squareindices, 6));
+
+		s_Data->QuadVertexArray = VertexArray::Create();
+		s_Data->QuadVertexArray->AddVertexBuffer(squareVB);
+		s_Data->QuadVertexArray->SetIndexBuffer(squareIB);
 	}
 
 	void Renderer2D::Shutdown() {
+		DynamicResolution::Shutdown();
+		PostProcessing::Shutdown();
+		RenderTargetPool::Shutdown();
 		delete s_Data;
+		s_Data = nullptr;
 	}
 
-	void Renderer2D::BeginScene(const Camera* camera) {
+	uint32_t Renderer2D::AcquireTextureHandle(const Ref<Texture2D>& texture) {
+		if (!texture)
+			return 0;
+
+		auto it = s_Data->TextureHandles.find(texture.get());
+		if (it != s_Data->TextureHandles.end()) {
+			s_Data->TextureSlots[it->second].References++;
+			return it->second;
+		}
+
+		uint32_t handle;
+		if (!s_Data->FreeTextureSlots.empty()) {
+			handle = s_Data->FreeTextureSlots.back();
+			s_Data->FreeTextureSlots.pop_back();
+		}
+		else {
+			handle = (uint32_t)s_Data->TextureSlots.size();
+			s_Data->TextureSlots.emplace_back();
+		}
+		s_Data->TextureSlots[handle] = { texture, 1 };
+		s_Data->TextureHandles[texture.get()] = handle;
+		return handle;
+	}
+
+	void Renderer2D::ReleaseTextureHandle(uint32_t handle) {
+		//Scenes can outlive the renderer on shutdown
+		if (!s_Data || handle == 0)
+			return;
+
+		TextureSlot& slot = s_Data->TextureSlots[handle];
+		if (--slot.References > 0)
+			return;
+		s_Data->TextureHandles.erase(slot.Texture.get());
+		slot.Texture = nullptr;
+		s_Data->FreeTextureSlots.push_back(handle);
+	}
+
+	const Ref<Texture2D>& Renderer2D::GetTexture(uint32_t handle) {
+		return s_Data->TextureSlots[handle].Texture;
+	}
 
+	static void SetViewProjection(const glm::mat4& viewProjection) {
 		for (auto& mat : s_Data->MaterialCache) {
 			mat.second->Bind();
-			mat.second->GetShader()->SetMat4("u_ViewProjection", camera->GetViewProjection());
+			mat.second->GetShader()->SetMat4("u_ViewProjection", viewProjection);
 		}
+	}
+
+	static void ApplyRenderScale(float scale) {
+		glm::uvec2 size = glm::max(glm::uvec2(glm::vec2(s_Data->OutputSize) * scale + 0.5f), glm::uvec2(1));
+		const FramebufferSpecification& spec = s_Data->RenderTarget->GetSpecification();
+		if (spec.Width != size.x || spec.Height != size.y)
+			s_Data->RenderTarget->Resize(size.x, size.y);
+	}
+
+	void Renderer2D::BeginScene(const Camera* camera) {
+		//Resized before the camera reads the target size so the aspect ratio is the one drawn at
+		ApplyRenderScale(DynamicResolution::BeginFrame());
+		s_Data->ViewProjection = camera->GetViewProjection();
+		s_Data->Projection = camera->GetProjection();
+		s_Data->FrameIndex++;
+		s_Data->Stats = Statistics();
+		s_Data->Output = s_Data->RenderTarget;
+		SetViewProjection(s_Data->ViewProjection);
+		s_Data->Lighting.Enabled = false;
+		s_Data->MaterialCache["SurfMaterial_Sprite"]->Bind();
+		s_Data->MaterialCache["SurfMaterial_Sprite"]->GetShader()->SetInt("u_Lit", 0);
 
 		s_Data->RenderTarget->Bind();
 		s_Data->RenderTarget->ClearAttachment(1, -1);
@@ -56,8 +268,65 @@ namespace SurfEngine{
 		RenderCommand::Clear();
 	}
 
+	static void ReleaseStaticTile(StaticLayerTile& tile) {
+		if (tile.Target && s_Data->FreeStaticTiles.size() < s_MaxStaticTilesPerLayer)
+			s_Data->FreeStaticTiles.push_back(tile.Target);
+		tile.Target = nullptr;
+	}
+
+	static void ReleaseStaticTiles(StaticLayerCache& cache) {
+		for (auto& [key, tile] : cache.Tiles)
+			ReleaseStaticTile(tile);
+		cache.Tiles.clear();
+	}
+
 	void Renderer2D::EndScene() {
+		FlushText();
+		SetSpritePass(SpritePass::Painter);
 		s_Data->RenderTarget->Unbind();
+		DynamicResolution::EndFrame();
+
+		//Drop tiles and layers that have been off screen for a while
+		for (auto layer = s_Data->StaticLayers.begin(); layer != s_Data->StaticLayers.end();) {
+			StaticLayerCache& cache = layer->second;
+			if (cache.LastUsedFrame + s_StaticTileLifetime < s_Data->FrameIndex) {
+				ReleaseStaticTiles(cache);
+				layer = s_Data->StaticLayers.erase(layer);
+				continue;
+			}
+
+			for (auto tile = cache.Tiles.begin(); tile != cache.Tiles.end();) {
+				if (tile->second.LastUsedFrame + s_StaticTileLifetime < s_Data->FrameIndex) {
+					ReleaseStaticTile(tile->second);
+					tile = cache.Tiles.erase(tile);
+				}
+				else {
+					++tile;
+				}
+			}
+			++layer;
+		}
+
+		//Forget the outlines of released textures
+		if (s_Data->FrameIndex % s_StaticTileLifetime == 0) {
+			for (auto cache = s_Data->SpriteMeshes.begin(); cache != s_Data->SpriteMeshes.end();) {
+				if (cache->second.Texture.expired())
+					cache = s_Data->SpriteMeshes.erase(cache);
+				else
+					++cache;
+			}
+
+			for (auto layout = s_Data->TextLayouts.begin(); layout != s_Data->TextLayouts.end();) {
+				if (layout->second.FontRef.expired() || layout->second.LastUsedFrame + s_StaticTileLifetime < s_Data->FrameIndex)
+					layout = s_Data->TextLayouts.erase(layout);
+				else
+					++layout;
+			}
+		}
+	}
+
+	const Renderer2D::Statistics& Renderer2D::GetStats() {
+		return s_Data->Stats;
 	}
 
 	bool Renderer2D::PushMaterial(const std::string& name, const Ref<Shader> shader) {
@@ -79,22 +348,45 @@ namespace SurfEngine{
 
 	void Renderer2D::SetRenderTarget(Ref<Framebuffer> frameBuffer) {
 		s_Data->RenderTarget = frameBuffer;
+		s_Data->Output = frameBuffer;
+		s_Data->OutputSize = { frameBuffer->GetSpecification().Width, frameBuffer->GetSpecification().Height };
+	}
+
+	const Ref<Framebuffer>& Renderer2D::GetRenderTarget() {
+		return s_Data->RenderTarget;
 	}
 
 	void Renderer2D::SetRenderSize(unsigned int x, unsigned int y) {
-		s_Data->RenderTarget->Resize(x, y);
+		ResizeRenderTarget(x, y);
 	}
 
 	void Renderer2D::ResizeRenderTarget(uint32_t width, uint32_t height) { 
-		s_Data->RenderTarget->Resize(width, height);
+		s_Data->OutputSize = { width, height };
+		ApplyRenderScale(DynamicResolution::GetStats().Scale);
+	}
+
+	glm::uvec2 Renderer2D::GetOutputSize() {
+		return s_Data->OutputSize;
 	}
 
 	glm::vec2 Renderer2D::GetRenderTargetSize() {
 		return { s_Data->RenderTarget->GetSpecification().Width, s_Data->RenderTarget->GetSpecification().Height};
 	}
 	
+	void Renderer2D::SetOutput(const Ref<Framebuffer>& output) {
+		s_Data->Output = output;
+	}
+
+	const Ref<Framebuffer>& Renderer2D::GetOutput() {
+		return s_Data->Output ? s_Data->Output : s_Data->RenderTarget;
+	}
+
 	uint32_t Renderer2D::GetOutputAsTextureId() {
-		return s_Data->RenderTarget->GetColorAttachmentRendererID();
+		return GetOutput()->GetColorAttachmentRendererID();
+	}
+
+	glm::vec2 Renderer2D::GetOutputUVScale() {
+		return GetOutput()->GetUVScale();
 	}
 
 	void Renderer2D::ClearRenderTarget() {
@@ -122,151 +414,250 @@ namespace SurfEngine{
 	}
 
 	void Renderer2D::DrawQuad(glm::mat4 transform, glm::vec4 color) {
-		//Quad Verticies x,y,z, texX, texY
-		float SquareVertices[5 * 4] = {
-			0.50f, 0.5f, 0.0f, 0.0f, 0.0f,
-			-0.5f, 0.5f, 0.0f, 1.0f, 0.0f,
-			-0.5f, -0.5f, 0.0f, 1.0f, 1.0f,
-			0.5f, -0.5f, 0.0f, 0.0f, 1.0f,
-		};
+		s_Data->MaterialCache["SurfMaterial_Color"]->Bind();
+		s_Data->MaterialCache["SurfMaterial_Color"]->GetShader()->SetMat4("u_Transform", transform);
+		s_Data->MaterialCache["SurfMaterial_Color"]->GetShader()->SetFloat4("u_Color", color);
+		s_Data->MaterialCache["SurfMaterial_Color"]->GetShader()->SetFloat("u_Depth", 0.0f);
 
-		uint32_t squareindices[6] = { 0, 1, 2, 2, 3, 0 };
+		s_Data->QuadVertexArray->Bind();
 
-		//Create VertexBuffer
-		Ref<VertexBuffer> squareVB;
-		squareVB.reset(VertexBuffer::Create(SquareVertices, sizeof(SquareVertices)));
+		RenderCommand::DrawIndexed(s_Data->QuadVertexArray);
+	}
 
-		squareVB->SetLayout({
-			{ShaderDataType::Float3, "a_Position"},
-			{ShaderDataType::Float2, "a_TexCoord"},
-			});
+	static void SetSpriteUniforms(const Ref<Shader>& shader, float depth, const glm::vec4& animation, float frameCount, float alphaCutoff = 0.0f) {
+		shader->SetFloat("u_Depth", depth);
+		shader->SetFloat4("u_Animation", animation);
+		shader->SetFloat("u_FrameCount", frameCount);
+		shader->SetFloat("u_AlphaCutoff", alphaCutoff);
+	}
 
-		//Create Index Buffer and Assign it
-		std::shared_ptr<IndexBuffer> squareIB;
-		squareIB.reset(IndexBuffer::Create(squareindices, 6));
+	//Each layer owns the depth slice (layer - 98.5, layer - 98], tilemaps and particles sit at its back
+	static float GetLayerDepth(unsigned int layer, float order) {
+		return layer - 98.5f + 0.5f * order;
+	}
 
-		//Create VertexArray and assign VertexBuffer/ Index Buffer
-		s_Data->VertexArray = VertexArray::Create();
-		s_Data->VertexArray->AddVertexBuffer(squareVB);
-		s_Data->VertexArray->SetIndexBuffer(squareIB);
+	void Renderer2D::SetSpritePass(SpritePass pass) {
+		if (s_Data->SpritePass == pass)
+			return;
 
+		s_Data->SpritePass = pass;
+		switch (pass) {
+		case SpritePass::Painter:		RenderCommand::SetDepthMode(RendererAPI::DepthMode::Off); break;
+		case SpritePass::Opaque:		RenderCommand::SetDepthMode(RendererAPI::DepthMode::TestAndWrite); break;
+		case SpritePass::Translucent:	RenderCommand::SetDepthMode(RendererAPI::DepthMode::Test); break;
+		}
+	}
 
-		s_Data->MaterialCache["SurfMaterial_Color"]->Bind();
-		s_Data->MaterialCache["SurfMaterial_Color"]->GetShader()->SetMat4("u_Transform", transform);
-		s_Data->MaterialCache["SurfMaterial_Color"]->GetShader()->SetFloat4("u_Color", color);
+	bool Renderer2D::IsSpriteOpaque(const SpriteRendererComponent& sprite) {
+		if (sprite.Color.a < 1.0f)
+			return false;
+		return !sprite.Texture || sprite.Texture->GetAlphaMode() != Texture2D::AlphaMode::Translucent;
+	}
 
-		s_Data->VertexArray->Bind();
+	//Outlines are only valid for the untransformed texture coordinates they were built from
+	static Ref<SpriteMesh> GetSpriteMesh(const SpriteRenderData& sprite, const Ref<Texture2D>& texture, int frames) {
+		if (sprite.MeshVertexBudget < 3 || sprite.Scaling != glm::vec2(1.0f) || sprite.Offset != glm::vec2(0.0f))
+			return nullptr;
 
-		RenderCommand::DrawIndexed(s_Data->VertexArray);
-	}
+		SpriteMeshCache& cache = s_Data->SpriteMeshes[texture.get()];
+		if (cache.Texture.lock() != texture) {
+			cache.Texture = texture;
+			cache.Meshes.clear();
+		}
 
-	void Renderer2D::DrawQuad(glm::mat4 transform, Ref<SpriteRendererComponent> src) {
-		DrawQuad(transform, src, 1,1);
+		uint64_t key = ((uint64_t)frames << 32) | sprite.MeshVertexBudget;
+		auto mesh = cache.Meshes.find(key);
+		if (mesh == cache.Meshes.end())
+			mesh = cache.Meshes.emplace(key, SpriteMesh::Create(*texture, frames, sprite.MeshVertexBudget)).first;
+		return mesh->second;
 	}
 
-	void Renderer2D::DrawQuad(glm::mat4 transform, Ref<SpriteRendererComponent> src, int frame, int totalFrames) {
-		//Quad Verticies x,y,z, texX, texY
-		float layer = src->Layer-98.f;
+	void Renderer2D::DrawSprite(const glm::mat4& transform, const SpriteRenderData& sprite, const AnimationComponent* animation, float order) {
+		float depth = GetLayerDepth(sprite.Layer, order);
+		if (!sprite.Texture && !s_Data->Lighting.Enabled) {
+			Ref<Shader> shader = s_Data->MaterialCache["SurfMaterial_Color"]->GetShader();
+			s_Data->MaterialCache["SurfMaterial_Color"]->Bind();
+			shader->SetMat4("u_Transform", transform);
+			shader->SetFloat4("u_Color", sprite.Color);
+			shader->SetFloat("u_Depth", depth);
 
-		glm::vec2 spriteUvs[4] = {
-			{(float)frame / (float)totalFrames,0.0f},
-			{((float)frame - 1.0f) / (float)totalFrames,0.0f},
-			{((float)frame - 1.0f) / (float)totalFrames,1.0f},
-			{(float)frame / (float)totalFrames,1.0f}
-		};
+			s_Data->QuadVertexArray->Bind();
 
-		float outputX[4];
-		if (src->flipX) {
-			outputX[0] = spriteUvs[1].x;
-			outputX[1] = spriteUvs[0].x;
-			outputX[2] = spriteUvs[3].x;
-			outputX[3] = spriteUvs[2].x;
-		}
-		else {
-			outputX[0] = spriteUvs[0].x;
-			outputX[1] = spriteUvs[1].x;
-			outputX[2] = spriteUvs[2].x;
-			outputX[3] = spriteUvs[3].x;
+			RenderCommand::DrawIndexed(s_Data->QuadVertexArray);
+			return;
 		}
 
-		float SquareVertices[5 * 4] = {
-			0.5f, 0.5f, layer, outputX[0], spriteUvs[0].y, // top right
-		   -0.5f, 0.5f, layer, outputX[1], spriteUvs[1].y, // top left
-		   -0.5f, -0.5, layer, outputX[2], spriteUvs[2].y, // bottom left
-			0.5f, -0.5, layer, outputX[3], spriteUvs[3].y, //bottom right
-		};
+		//The shader picks the frame from the animation start time, stopped animations hold their frame
+		glm::vec4 frameState = glm::vec4(0.0f);
+		float frameCount = 1.0f;
+		if (animation) {
+			frameCount = (float)std::max(animation->frames, 1);
+			frameState.x = animation->startTime;
+			frameState.y = animation->play ? (float)animation->fps : 0.0f;
+			frameState.z = (float)(animation->currframe - 1);
+			frameState.w = animation->loop ? 1.0f : 0.0f;
+		}
 
-		uint32_t squareindices[6] = { 0, 1, 2, 2, 3, 0 };
+		glm::mat4 spriteTransform = (sprite.Flags & SpriteRenderData::FlipX) ? glm::scale(transform, glm::vec3(-1.0f, 1.0f, 1.0f)) : transform;
 
-		//Create VertexBuffer
-		Ref<VertexBuffer> squareVB;
-		squareVB.reset(VertexBuffer::Create(SquareVertices, sizeof(SquareVertices)));
+		Ref<Shader> shader = s_Data->MaterialCache["SurfMaterial_Sprite"]->GetShader();
+		s_Data->MaterialCache["SurfMaterial_Sprite"]->Bind();
+		shader->SetMat4("u_Transform", spriteTransform);
+		shader->SetFloat4("u_Color", sprite.Color);
+		shader->SetFloat2("u_Scale", sprite.Scaling);
+		shader->SetFloat2("u_Offset", sprite.Offset);
+		shader->SetInt("u_Texture", 0);
+		//Cutout texels are discarded so they leave no depth behind
+		const Ref<Texture2D>& texture = sprite.Texture ? GetTexture(sprite.Texture) : s_Data->WhiteTexture;
+		bool cutout = s_Data->SpritePass == SpritePass::Opaque && (sprite.Flags & SpriteRenderData::Cutout);
+		SetSpriteUniforms(shader, depth, frameState, frameCount, cutout ? 0.5f : 0.0f);
+		texture->Bind();
+		shader->SetInt("u_HasNormalMap", sprite.NormalMap ? 1 : 0);
+		if (sprite.NormalMap) {
+			shader->SetInt("u_NormalMap", s_NormalMapSlot);
+			GetTexture(sprite.NormalMap)->Bind(s_NormalMapSlot);
+		}
 
-		squareVB->SetLayout({
-			{ShaderDataType::Float3, "a_Position"},
-			{ShaderDataType::Float2, "a_TexCoord"},
-			});
+		//Fill rate is measured against what the full quad would have covered on screen
+		Ref<SpriteMesh> mesh = sprite.Texture ? GetSpriteMesh(sprite, texture, (int)frameCount) : nullptr;
+		glm::mat4 mvp = s_Data->ViewProjection * spriteTransform;
+		glm::vec2 size = GetRenderTargetSize();
+		float quadPixels = fabsf(mvp[0][0] * mvp[1][1] - mvp[0][1] * mvp[1][0]) * 0.25f * size.x * size.y;
+		s_Data->Stats.Sprites++;
+		s_Data->Stats.QuadPixels += quadPixels;
+		s_Data->Stats.DrawnPixels += mesh ? quadPixels * mesh->GetCoverage() : quadPixels;
+		if (mesh)
+			s_Data->Stats.MeshSprites++;
 
-		//Create Index Buffer and Assign it
-		std::shared_ptr<IndexBuffer> squareIB;
-		squareIB.reset(IndexBuffer::Create(squareindices, 6));
+		const Ref<VertexArray>& vertexArray = mesh ? mesh->GetVertexArray() : s_Data->QuadVertexArray;
+		if (!vertexArray)
+			return;
 
-		//Create VertexArray and assign VertexBuffer/ Index Buffer
-		s_Data->VertexArray = VertexArray::Create();
-		s_Data->VertexArray->AddVertexBuffer(squareVB);
-		s_Data->VertexArray->SetIndexBuffer(squareIB);
+		vertexArray->Bind();
 
+		RenderCommand::DrawIndexed(vertexArray);
+	}
 
+	void Renderer2D::SetTime(float time) {
 		s_Data->MaterialCache["SurfMaterial_Sprite"]->Bind();
-		s_Data->MaterialCache["SurfMaterial_Sprite"]->GetShader()->SetMat4("u_Transform", transform);
-		s_Data->MaterialCache["SurfMaterial_Sprite"]->GetShader()->SetFloat4("u_Color", src->Color);
-		s_Data->MaterialCache["SurfMaterial_Sprite"]->GetShader()->SetFloat2("u_Scale", src->scaling);
-		s_Data->MaterialCache["SurfMaterial_Sprite"]->GetShader()->SetFloat2("u_Offset", src->offset);
-		s_Data->MaterialCache["SurfMaterial_Sprite"]->GetShader()->SetInt("u_Texture", 0);
-		src->Texture->Bind();
-
-		s_Data->VertexArray->Bind();
+		s_Data->MaterialCache["SurfMaterial_Sprite"]->GetShader()->SetFloat("u_Time", time);
+	}
 
-		RenderCommand::DrawIndexed(s_Data->VertexArray);
+	void Renderer2D::BeginLighting(const glm::vec3& ambient) {
+		LightingStorage& lighting = s_Data->Lighting;
+		lighting.Ambient = ambient;
+		lighting.LightTexels.clear();
+		lighting.Bounds.clear();
 	}
 
-	void Renderer2D::DrawCircle(glm::mat4 transform, glm::vec4 color) {
-		//Quad Verticies x,y,z, texX, texY
-		float SquareVertices[5 * 4] = {
-			0.50f, 0.5f, 0.0f, 0.0f, 0.0f,
-			-0.5f, 0.5f, 0.0f, 1.0f, 0.0f,
-			-0.5f, -0.5f, 0.0f, 1.0f, 1.0f,
-			0.5f, -0.5f, 0.0f, 0.0f, 1.0f,
-		};
+	void Renderer2D::SubmitLight(const glm::mat4& transform, const LightComponent& light) {
+		LightingStorage& lighting = s_Data->Lighting;
+		glm::vec3 color = light.Color * light.Intensity;
+		if (light.LightType == LightComponent::Type::Global) {
+			lighting.Ambient += color;
+			return;
+		}
+		if (lighting.Bounds.size() >= s_MaxLights || light.Radius <= 0.0f)
+			return;
+
+		//Spot lights point along the entity's x axis, cone angles are stored as half angle cosines
+		glm::vec2 position = glm::vec2(transform[3]);
+		glm::vec2 direction = glm::vec2(transform[0]);
+		direction = glm::length(direction) > 0.0f ? glm::normalize(direction) : glm::vec2(1.0f, 0.0f);
+		float outer = glm::radians(glm::clamp(light.OuterAngle, 0.0f, 360.0f) * 0.5f);
+		float inner = glm::radians(glm::clamp(light.InnerAngle, 0.0f, 360.0f) * 0.5f);
+		float spot = light.LightType == LightComponent::Type::Spot ? 1.0f : 0.0f;
+
+		lighting.LightTexels.push_back(glm::vec4(position, light.Radius, light.Height));
+		lighting.LightTexels.push_back(glm::vec4(color, spot));
+		lighting.LightTexels.push_back(glm::vec4(direction, glm::cos(std::min(inner, outer)), glm::cos(outer)));
+		lighting.Bounds.push_back(glm::vec3(position, light.Radius));
+	}
 
-		uint32_t squareindices[6] = { 0, 1, 2, 2, 3, 0 };
+	void Renderer2D::EndLighting() {
+		LightingStorage& lighting = s_Data->Lighting;
+		const uint32_t lightCount = (uint32_t)lighting.Bounds.size();
+		glm::vec2 size = GetRenderTargetSize();
+		glm::uvec2 tileCount = glm::max(glm::uvec2((glm::vec2(size) + (float)(s_LightTileSize - 1)) / (float)s_LightTileSize), glm::uvec2(1));
+		const uint32_t tiles = tileCount.x * tileCount.y;
+		if (!lighting.Tiles || lighting.TileCount != tileCount) {
+			lighting.Tiles = Texture2D::Create(tileCount.x, tileCount.y, Texture2D::Format::RGBA32F);
+			lighting.TileCount = tileCount;
+		}
 
-		//Create VertexBuffer
-		Ref<VertexBuffer> squareVB;
-		squareVB.reset(VertexBuffer::Create(SquareVertices, sizeof(SquareVertices)));
+		//Screen rect of every light's bounding square in tiles, rows counted from the bottom like gl_FragCoord
+		lighting.LightRects.resize(lightCount);
+		lighting.TileOffsets.assign((size_t)tiles + 1, 0);
+		for (uint32_t i = 0; i < lightCount; i++) {
+			const glm::vec3& bounds = lighting.Bounds[i];
+			glm::vec2 screenMin(FLT_MAX), screenMax(-FLT_MAX);
+			for (glm::vec2 corner : { glm::vec2(-1.0f, -1.0f), glm::vec2(1.0f, -1.0f), glm::vec2(1.0f, 1.0f), glm::vec2(-1.0f, 1.0f) }) {
+				glm::vec4 p = s_Data->ViewProjection * glm::vec4(glm::vec2(bounds) + corner * bounds.z, 0.0f, 1.0f);
+				glm::vec2 pixel = (glm::vec2(p) / p.w * 0.5f + 0.5f) * size;
+				screenMin = glm::min(screenMin, pixel);
+				screenMax = glm::max(screenMax, pixel);
+			}
+			glm::ivec4& rect = lighting.LightRects[i];
+			rect = glm::ivec4(glm::floor(screenMin / (float)s_LightTileSize), glm::floor(screenMax / (float)s_LightTileSize));
+			rect = glm::ivec4(glm::max(glm::ivec2(rect.x, rect.y), glm::ivec2(0)), glm::min(glm::ivec2(rect.z, rect.w), glm::ivec2(tileCount) - 1));
+			for (int y = rect.y; y <= rect.w; y++)
+				for (int x = rect.x; x <= rect.z; x++)
+					lighting.TileOffsets[(size_t)y * tileCount.x + x + 1]++;
+		}
 
-		squareVB->SetLayout({
-			{ShaderDataType::Float3, "a_Position"},
-			{ShaderDataType::Float2, "a_TexCoord"},
-			});
+		//Counts to offsets, then every light writes its index into the tiles it covers
+		for (uint32_t tile = 0; tile < tiles; tile++)
+			lighting.TileOffsets[tile + 1] += lighting.TileOffsets[tile];
+		const uint32_t entries = lighting.TileOffsets[tiles];
+		lighting.TileTexels.resize(tiles);
+		for (uint32_t tile = 0; tile < tiles; tile++)
+			lighting.TileTexels[tile] = glm::vec4((float)lighting.TileOffsets[tile], (float)(lighting.TileOffsets[tile + 1] - lighting.TileOffsets[tile]), 0.0f, 0.0f);
+
+		uint32_t indexRows = std::max((entries + 4 * s_LightIndexWidth - 1) / (4 * s_LightIndexWidth), 1u);
+		if (!lighting.Indices || lighting.IndexRows < indexRows) {
+			lighting.Indices = Texture2D::Create(s_LightIndexWidth, indexRows, Texture2D::Format::RGBA32F);
+			lighting.IndexRows = indexRows;
+		}
+		lighting.IndexList.assign((size_t)lighting.IndexRows * s_LightIndexWidth * 4, 0.0f);
+		for (uint32_t i = 0; i < lightCount; i++) {
+			const glm::ivec4& rect = lighting.LightRects[i];
+			for (int y = rect.y; y <= rect.w; y++)
+				for (int x = rect.x; x <= rect.z; x++)
+					lighting.IndexList[lighting.TileOffsets[(size_t)y * tileCount.x + x]++] = (float)i;
+		}
 
-		//Create Index Buffer and Assign it
-		std::shared_ptr<IndexBuffer> squareIB;
-		squareIB.reset(IndexBuffer::Create(squareindices, 6));
+		lighting.LightTexels.resize((size_t)s_LightTexels * s_MaxLights, glm::vec4(0.0f));
+		lighting.LightData->SetData(lighting.LightTexels.data(), (uint32_t)(lighting.LightTexels.size() * sizeof(glm::vec4)));
+		lighting.Tiles->SetData(lighting.TileTexels.data(), (uint32_t)(lighting.TileTexels.size() * sizeof(glm::vec4)));
+		lighting.Indices->SetData(lighting.IndexList.data(), (uint32_t)(lighting.IndexList.size() * sizeof(float)));
 
-		//Create VertexArray and assign VertexBuffer/ Index Buffer
-		s_Data->VertexArray = VertexArray::Create();
-		s_Data->VertexArray->AddVertexBuffer(squareVB);
-		s_Data->VertexArray->SetIndexBuffer(squareIB);
+		lighting.LightData->Bind(s_LightDataSlot);
+		lighting.Tiles->Bind(s_LightTilesSlot);
+		lighting.Indices->Bind(s_LightIndicesSlot);
 
+		Ref<Shader> shader = s_Data->MaterialCache["SurfMaterial_Sprite"]->GetShader();
+		s_Data->MaterialCache["SurfMaterial_Sprite"]->Bind();
+		shader->SetInt("u_Lit", 1);
+		shader->SetFloat3("u_Ambient", lighting.Ambient);
+		shader->SetFloat("u_LightTileSize", (float)s_LightTileSize);
+		shader->SetInt("u_LightData", s_LightDataSlot);
+		shader->SetInt("u_LightTiles", s_LightTilesSlot);
+		shader->SetInt("u_LightIndices", s_LightIndicesSlot);
+		shader->SetInt("u_HasNormalMap", 0);
+
+		lighting.Enabled = true;
+		s_Data->Stats.Lights = lightCount;
+		s_Data->Stats.LightTileEntries = entries;
+	}
 
+	void Renderer2D::DrawCircle(glm::mat4 transform, glm::vec4 color) {
 		s_Data->MaterialCache["SurfMaterial_Circle"]->Bind();
 		s_Data->MaterialCache["SurfMaterial_Circle"]->GetShader()->SetMat4("u_Transform", transform);
 		s_Data->MaterialCache["SurfMaterial_Circle"]->GetShader()->SetFloat4("u_Color", color);
 
-		s_Data->VertexArray->Bind();
+		s_Data->QuadVertexArray->Bind();
 
-		RenderCommand::DrawIndexed(s_Data->VertexArray);
+		RenderCommand::DrawIndexed(s_Data->QuadVertexArray);
 	}
 
 	void Renderer2D::DrawLine(glm::vec2 start, glm::vec2 end, glm::mat4 transform, glm::vec4 color) {
@@ -391,4 +782,405 @@ namespace SurfEngine{
 		s_Data->VertexArray->Bind();
 		RenderCommand::DrawIndexed(s_Data->VertexArray);
 	}
+
+	static void BuildStaticTile(StaticLayerTile& tile, const glm::vec2& tileMin, float tileWorldSize, const std::function<void()>& drawContents) {
+		if (!tile.Target) {
+			if (!s_Data->FreeStaticTiles.empty()) {
+				tile.Target = s_Data->FreeStaticTiles.back();
+				s_Data->FreeStaticTiles.pop_back();
+			}
+			else {
+				FramebufferSpecification spec;
+				spec.Attachments = { FramebufferTextureFormat::RGBA8 };
+				spec.Width = s_StaticTileSize;
+				spec.Height = s_StaticTileSize;
+				tile.Target = Framebuffer::Create(spec);
+			}
+		}
+
+		//Sprites keep straight alpha, blending them into a cleared tile leaves it premultiplied
+		Renderer2D::SpritePass pass = s_Data->SpritePass;
+		Renderer2D::SetSpritePass(Renderer2D::SpritePass::Painter);
+		SetViewProjection(glm::ortho(tileMin.x, tileMin.x + tileWorldSize, tileMin.y, tileMin.y + tileWorldSize, -1000.0f, 1000.0f));
+		//Light tiles are in screen pixels, the cached tile stays unlit and is lit when it is composited
+		s_Data->MaterialCache["SurfMaterial_Sprite"]->Bind();
+		s_Data->MaterialCache["SurfMaterial_Sprite"]->GetShader()->SetInt("u_Lit", 0);
+		tile.Target->Bind();
+		RenderCommand::SetClearColor(glm::vec4(0.0f));
+		RenderCommand::Clear();
+		RenderCommand::SetBlendMode(RendererAPI::BlendMode::AlphaToPremultiplied);
+		drawContents();
+		RenderCommand::SetBlendMode(RendererAPI::BlendMode::Alpha);
+		Renderer2D::SetSpritePass(pass);
+
+		SetViewProjection(s_Data->ViewProjection);
+		s_Data->MaterialCache["SurfMaterial_Sprite"]->Bind();
+		s_Data->MaterialCache["SurfMaterial_Sprite"]->GetShader()->SetInt("u_Lit", s_Data->Lighting.Enabled ? 1 : 0);
+		s_Data->RenderTarget->Bind();
+	}
+
+	static void DrawStaticTile(const StaticLayerTile& tile, const glm::mat4& transform, float layer) {
+		Ref<Shader> shader = s_Data->MaterialCache["SurfMaterial_Sprite"]->GetShader();
+		s_Data->MaterialCache["SurfMaterial_Sprite"]->Bind();
+		shader->SetMat4("u_Transform", transform);
+		shader->SetFloat4("u_Color", glm::vec4(1.0f));
+		shader->SetFloat2("u_Scale", tile.Target->GetUVScale());
+		shader->SetFloat2("u_Offset", glm::vec2(0.0f));
+		shader->SetInt("u_Texture", 0);
+		shader->SetInt("u_HasNormalMap", 0);
+		SetSpriteUniforms(shader, layer, glm::vec4(0.0f), 1.0f);
+		RenderCommand::BindTextureID(0, tile.Target->GetColorAttachmentRendererID());
+
+		s_Data->QuadVertexArray->Bind();
+
+		RenderCommand::SetBlendMode(RendererAPI::BlendMode::PremultipliedAlpha);
+		RenderCommand::DrawIndexed(s_Data->QuadVertexArray);
+		RenderCommand::SetBlendMode(RendererAPI::BlendMode::Alpha);
+	}
+
+	void Renderer2D::DrawStaticLayer(unsigned int layer, size_t contentHash, const glm::vec4& bounds, const std::function<void()>& drawContents) {
+		StaticLayerCache& cache = s_Data->StaticLayers[layer];
+		cache.LastUsedFrame = s_Data->FrameIndex;
+
+		//Cache resolution follows the camera zoom so tiles stay pixel accurate
+		//It is taken at the output size, dynamic resolution only changes how finely the tiles are sampled
+		float pixelsPerUnit = glm::abs(s_Data->Projection[1][1]) * 0.5f * (float)GetOutputSize().y;
+		if (cache.ContentHash != contentHash || cache.PixelsPerUnit != pixelsPerUnit) {
+			//Draw directly on the frame something changed, layers that change every frame never pay for rebuilds
+			ReleaseStaticTiles(cache);
+			cache.ContentHash = contentHash;
+			cache.PixelsPerUnit = pixelsPerUnit;
+			drawContents();
+			return;
+		}
+
+		//Visible part of the layer in world space
+		glm::mat4 inverseViewProjection = glm::inverse(s_Data->ViewProjection);
+		glm::vec2 viewMin(FLT_MAX), viewMax(-FLT_MAX);
+		for (glm::vec2 corner : { glm::vec2(-1.0f, -1.0f), glm::vec2(1.0f, -1.0f), glm::vec2(1.0f, 1.0f), glm::vec2(-1.0f, 1.0f) }) {
+			glm::vec4 p = inverseViewProjection * glm::vec4(corner, 0.0f, 1.0f);
+			viewMin = glm::min(viewMin, glm::vec2(p) / p.w);
+			viewMax = glm::max(viewMax, glm::vec2(p) / p.w);
+		}
+		glm::vec2 areaMin = glm::max(viewMin, glm::vec2(bounds.x, bounds.y));
+		glm::vec2 areaMax = glm::min(viewMax, glm::vec2(bounds.z, bounds.w));
+		if (areaMin.x > areaMax.x || areaMin.y > areaMax.y)
+			return;
+
+		float tileWorldSize = (float)s_StaticTileSize / pixelsPerUnit;
+		glm::ivec2 first = glm::ivec2(glm::floor(areaMin / tileWorldSize));
+		glm::ivec2 last = glm::ivec2(glm::floor(areaMax / tileWorldSize));
+		if ((uint64_t)(last.x - first.x + 1) * (uint64_t)(last.y - first.y + 1) > s_MaxStaticTilesPerLayer) {
+			drawContents();
+			return;
+		}
+
+		float depth = (float)layer - 98.0f;
+		for (int y = first.y; y <= last.y; y++) {
+			for (int x = first.x; x <= last.x; x++) {
+				uint64_t key = ((uint64_t)(uint32_t)x << 32) | (uint32_t)y;
+				StaticLayerTile& tile = cache.Tiles[key];
+				glm::vec2 tileMin = glm::vec2((float)x, (float)y) * tileWorldSize;
+				if (!tile.Target)
+					BuildStaticTile(tile, tileMin, tileWorldSize, drawContents);
+				tile.LastUsedFrame = s_Data->FrameIndex;
+
+				//Tile rows are stored bottom up, unlike sprite textures, so the quad is mirrored vertically
+				glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3(tileMin + glm::vec2(tileWorldSize * 0.5f), 0.0f));
+				transform = glm::scale(transform, glm::vec3(tileWorldSize, -tileWorldSize, 1.0f));
+				DrawStaticTile(tile, transform, depth);
+			}
+		}
+	}
+
+	static Ref<VertexArray> BuildTilemapChunk(const TilemapComponent& tilemap, const TilemapComponent::Chunk& chunk) {
+		const int columns = std::max(tilemap.Columns, 1);
+		const int rows = std::max(tilemap.Rows, 1);
+		const float layer = tilemap.Layer - 98.f;
+
+		//Quad Verticies x,y,z, texX, texY in chunk space
+		std::vector<float> vertices;
+		std::vector<uint32_t> indices;
+		vertices.reserve(chunk.TileCount * 4 * 5);
+		indices.reserve(chunk.TileCount * 6);
+
+		for (int y = 0; y < TilemapComponent::ChunkSize; y++) {
+			for (int x = 0; x < TilemapComponent::ChunkSize; x++) {
+				int tile = chunk.Tiles[y * TilemapComponent::ChunkSize + x];
+				if (tile < 0 || tile >= columns * rows)
+					continue;
+
+				//Tileset rows count down from the top of the image
+				float u0 = (float)(tile % columns) / columns;
+				float u1 = (float)(tile % columns + 1) / columns;
+				float vTop = 1.0f - (float)(tile / columns) / rows;
+				float vBottom = 1.0f - (float)(tile / columns + 1) / rows;
+				float x0 = (float)x, x1 = (float)x + 1.0f;
+				float y0 = (float)y, y1 = (float)y + 1.0f;
+
+				uint32_t base = (uint32_t)(vertices.size() / 5);
+				vertices.insert(vertices.end(), {
+					x1, y0, layer, u1, vTop,
+					x0, y0, layer, u0, vTop,
+					x0, y1, layer, u0, vBottom,
+					x1, y1, layer, u1, vBottom,
+				});
+				indices.insert(indices.end(), { base, base + 1, base + 2, base + 2, base + 3, base });
+			}
+		}
+
+		if (indices.empty())
+			return nullptr;
+
+		Ref<VertexBuffer> chunkVB;
+		chunkVB.reset(VertexBuffer::Create(vertices.data(), (uint32_t)(vertices.size() * sizeof(float))));
+		chunkVB->SetLayout({
+			{ShaderDataType::Float3, "a_Position"},
+			{ShaderDataType::Float2, "a_TexCoord"},
+			});
+
+		std::shared_ptr<IndexBuffer> chunkIB;
+		chunkIB.reset(IndexBuffer::Create(indices.data(), (uint32_t)indices.size()));
+
+		Ref<VertexArray> mesh = VertexArray::Create();
+		mesh->AddVertexBuffer(chunkVB);
+		mesh->SetIndexBuffer(chunkIB);
+		return mesh;
+	}
+
+	void Renderer2D::DrawTilemap(const glm::mat4& transform, TilemapComponent& tilemap) {
+		if (!tilemap.Tileset || tilemap.Chunks.empty())
+			return;
+
+		//Visible rect in tilemap space
+		glm::mat4 inverse = glm::inverse(s_Data->ViewProjection * transform);
+		glm::vec2 viewMin(FLT_MAX), viewMax(-FLT_MAX);
+		for (glm::vec2 corner : { glm::vec2(-1.0f, -1.0f), glm::vec2(1.0f, -1.0f), glm::vec2(1.0f, 1.0f), glm::vec2(-1.0f, 1.0f) }) {
+			glm::vec4 p = inverse * glm::vec4(corner, 0.0f, 1.0f);
+			viewMin = glm::min(viewMin, glm::vec2(p) / p.w);
+			viewMax = glm::max(viewMax, glm::vec2(p) / p.w);
+		}
+		glm::ivec2 first = glm::ivec2(glm::floor(viewMin / (float)TilemapComponent::ChunkSize));
+		glm::ivec2 last = glm::ivec2(glm::floor(viewMax / (float)TilemapComponent::ChunkSize));
+
+		Ref<Shader> shader = s_Data->MaterialCache["SurfMaterial_Sprite"]->GetShader();
+		s_Data->MaterialCache["SurfMaterial_Sprite"]->Bind();
+		shader->SetFloat4("u_Color", tilemap.Color);
+		shader->SetFloat2("u_Scale", glm::vec2(1.0f));
+		shader->SetFloat2("u_Offset", glm::vec2(0.0f));
+		shader->SetInt("u_Texture", 0);
+		shader->SetInt("u_HasNormalMap", 0);
+		//Chunk vertices already carry the layer depth, this moves them to the back of the layer's slice
+		SetSpriteUniforms(shader, -0.5f, glm::vec4(0.0f), 1.0f);
+		tilemap.Tileset->Bind();
+
+		auto drawChunk = [&](int chunkX, int chunkY, TilemapComponent::Chunk& chunk) {
+			if (chunk.Dirty) {
+				chunk.Mesh = BuildTilemapChunk(tilemap, chunk);
+				chunk.Dirty = false;
+			}
+			if (!chunk.Mesh)
+				return;
+
+			glm::vec3 origin((float)(chunkX * TilemapComponent::ChunkSize), (float)(chunkY * TilemapComponent::ChunkSize), 0.0f);
+			shader->SetMat4("u_Transform", glm::translate(transform, origin));
+			chunk.Mesh->Bind();
+			RenderCommand::DrawIndexed(chunk.Mesh);
+		};
+
+		//Zoomed far out the view can span more chunks than the map has
+		uint64_t visibleChunks = (uint64_t)(last.x - first.x + 1) * (uint64_t)(last.y - first.y + 1);
+		if (visibleChunks > tilemap.Chunks.size()) {
+			for (auto& [key, chunk] : tilemap.Chunks) {
+				int chunkX = (int)(uint32_t)(key >> 32), chunkY = (int)(uint32_t)key;
+				if (chunkX >= first.x && chunkX <= last.x && chunkY >= first.y && chunkY <= last.y)
+					drawChunk(chunkX, chunkY, chunk);
+			}
+			return;
+		}
+
+		for (int y = first.y; y <= last.y; y++) {
+			for (int x = first.x; x <= last.x; x++) {
+				auto it = tilemap.Chunks.find(TilemapComponent::GetChunkKey(x, y));
+				if (it != tilemap.Chunks.end())
+					drawChunk(x, y, it->second);
+			}
+		}
+	}
+
+	void Renderer2D::DrawParticles(ParticleEmitterComponent& emitter) {
+		if (!emitter.Pool || emitter.Pool->GetCount() == 0)
+			return;
+
+		const Ref<VertexArray>& vertexArray = emitter.Pool->GetVertexArray();
+
+		Ref<Shader> shader = s_Data->MaterialCache["SurfMaterial_Particle"]->GetShader();
+		s_Data->MaterialCache["SurfMaterial_Particle"]->Bind();
+		shader->SetFloat("u_Depth", GetLayerDepth(emitter.Layer, 0.0f));
+		shader->SetInt("u_Textured", emitter.Texture ? 1 : 0);
+		shader->SetInt("u_Texture", 0);
+		if (emitter.Texture)
+			emitter.Texture->Bind();
+
+		vertexArray->Bind();
+		RenderCommand::DrawIndexedInstanced(vertexArray, emitter.Pool->GetCount());
+	}
+
+	static const TextLayout& GetTextLayout(const Ref<Font>& font, const std::string& text, float kerning, float lineSpacing) {
+		size_t hash = std::hash<std::string>()(text);
+		hash ^= std::hash<const void*>()(font.get()) + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+		hash ^= std::hash<float>()(kerning) + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+		hash ^= std::hash<float>()(lineSpacing) + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+
+		TextLayout& layout = s_Data->TextLayouts[hash];
+		layout.LastUsedFrame = s_Data->FrameIndex;
+		if (layout.FontRef.lock() == font && layout.Text == text && layout.Kerning == kerning && layout.LineSpacing == lineSpacing)
+			return layout;
+
+		//New string or a hash collision, either way the entry is rebuilt for this string
+		layout.FontRef = font;
+		layout.Text = text;
+		layout.Kerning = kerning;
+		layout.LineSpacing = lineSpacing;
+		layout.Quads.clear();
+
+		const Font::Glyph* fallback = font->GetGlyph('?');
+		glm::vec2 pen = glm::vec2(0.0f);
+		uint32_t previous = 0;
+		for (unsigned char character : text) {
+			if (character == '\n') {
+				pen = glm::vec2(0.0f, pen.y + font->GetLineHeight() * lineSpacing);
+				previous = 0;
+				continue;
+			}
+			if (character == '\r')
+				continue;
+
+			const Font::Glyph* glyph = font->GetGlyph(character);
+			if (!glyph)
+				glyph = fallback;
+			pen.x += font->GetKerning(previous, character);
+			previous = character;
+
+			if (glyph->PlaneMax.x > glyph->PlaneMin.x && glyph->PlaneMax.y > glyph->PlaneMin.y) {
+				layout.Quads.insert(layout.Quads.end(), {
+					pen.x + glyph->PlaneMin.x, pen.y + glyph->PlaneMin.y, pen.x + glyph->PlaneMax.x, pen.y + glyph->PlaneMax.y,
+					glyph->UVMin.x, glyph->UVMin.y, glyph->UVMax.x, glyph->UVMax.y });
+			}
+			pen.x += glyph->Advance + kerning;
+		}
+		return layout;
+	}
+
+	void Renderer2D::DrawString(const std::string& text, const glm::mat4& transform, const glm::vec4& color, const Ref<Font>& font, float kerning, float lineSpacing) {
+		const Ref<Font>& usedFont = font ? font : s_Data->DefaultFont;
+		if (!usedFont || text.empty())
+			return;
+
+		const TextLayout& layout = GetTextLayout(usedFont, text, kerning, lineSpacing);
+		if (layout.Quads.empty())
+			return;
+
+		auto batch = std::find_if(s_Data->TextBatches.begin(), s_Data->TextBatches.end(), [&](const TextBatch& b) { return b.FontRef == usedFont; });
+		if (batch == s_Data->TextBatches.end()) {
+			s_Data->TextBatches.push_back({ usedFont, {} });
+			batch = s_Data->TextBatches.end() - 1;
+		}
+
+		std::vector<float>& vertices = batch->Vertices;
+		vertices.reserve(vertices.size() + layout.Quads.size() / 8 * 4 * 9);
+		for (size_t i = 0; i < layout.Quads.size(); i += 8) {
+			const float* quad = &layout.Quads[i];
+			const glm::vec2 corners[4] = { { quad[0], quad[1] }, { quad[2], quad[1] }, { quad[2], quad[3] }, { quad[0], quad[3] } };
+			const glm::vec2 uvs[4] = { { quad[4], quad[5] }, { quad[6], quad[5] }, { quad[6], quad[7] }, { quad[4], quad[7] } };
+			for (int corner = 0; corner < 4; corner++) {
+				glm::vec4 position = transform * glm::vec4(corners[corner], 0.0f, 1.0f);
+				vertices.insert(vertices.end(), { position.x, position.y, position.z, uvs[corner].x, uvs[corner].y, color.r, color.g, color.b, color.a });
+			}
+		}
+	}
+
+	void Renderer2D::DrawString(const glm::mat4& transform, const TextComponent& text) {
+		glm::mat4 layered = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, GetLayerDepth(text.Layer, 1.0f))) * transform;
+		DrawString(text.Text, layered, text.Color, text.FontAsset, text.Kerning, text.LineSpacing);
+	}
+
+	static void ReserveTextGlyphs(uint32_t glyphs) {
+		if (glyphs <= s_Data->TextGlyphCapacity)
+			return;
+
+		uint32_t capacity = std::max(s_Data->TextGlyphCapacity * 2, 256u);
+		while (capacity < glyphs)
+			capacity *= 2;
+
+		std::vector<uint32_t> indices((size_t)capacity * 6);
+		for (uint32_t i = 0; i < capacity; i++) {
+			uint32_t first = i * 4;
+			uint32_t* quad = &indices[(size_t)i * 6];
+			quad[0] = first; quad[1] = first + 1; quad[2] = first + 2;
+			quad[3] = first + 2; quad[4] = first + 3; quad[5] = first;
+		}
+
+		s_Data->TextVertexBuffer.reset(VertexBuffer::Create(capacity * 4 * 9 * (uint32_t)sizeof(float)));
+		s_Data->TextVertexBuffer->SetLayout({
+			{ShaderDataType::Float3, "a_Position"},
+			{ShaderDataType::Float2, "a_TexCoord"},
+			{ShaderDataType::Float4, "a_Color"},
+			});
+
+		std::shared_ptr<IndexBuffer> textIB;
+		textIB.reset(IndexBuffer::Create(indices.data(), (uint32_t)indices.size()));
+
+		s_Data->TextVertexArray = VertexArray::Create();
+		s_Data->TextVertexArray->AddVertexBuffer(s_Data->TextVertexBuffer);
+		s_Data->TextVertexArray->SetIndexBuffer(textIB);
+		s_Data->TextGlyphCapacity = capacity;
+	}
+
+	void Renderer2D::FlushText() {
+		bool queued = std::any_of(s_Data->TextBatches.begin(), s_Data->TextBatches.end(), [](const TextBatch& batch) { return !batch.Vertices.empty(); });
+		if (!queued)
+			return;
+
+		SetSpritePass(SpritePass::Painter);
+		Ref<Shader> shader = s_Data->MaterialCache["SurfMaterial_Text"]->GetShader();
+		s_Data->MaterialCache["SurfMaterial_Text"]->Bind();
+		shader->SetInt("u_Texture", 0);
+
+		for (TextBatch& batch : s_Data->TextBatches) {
+			uint32_t glyphs = (uint32_t)(batch.Vertices.size() / (4 * 9));
+			if (glyphs == 0)
+				continue;
+
+			ReserveTextGlyphs(glyphs);
+			s_Data->TextVertexBuffer->SetData(batch.Vertices.data(), (uint32_t)(batch.Vertices.size() * sizeof(float)));
+			batch.FontRef->GetAtlas()->Bind();
+			s_Data->TextVertexArray->Bind();
+			RenderCommand::DrawIndexed(s_Data->TextVertexArray, glyphs * 6);
+
+			s_Data->Stats.Glyphs += glyphs;
+			s_Data->Stats.TextDrawCalls++;
+			batch.Vertices.clear();
+		}
+
+		//Batches keep their storage between frames, unless nothing else uses their font anymore
+		s_Data->TextBatches.erase(std::remove_if(s_Data->TextBatches.begin(), s_Data->TextBatches.end(),
+			[](const TextBatch& batch) { return batch.FontRef.use_count() == 1; }), s_Data->TextBatches.end());
+	}
+
+	const Ref<Font>& Renderer2D::GetDefaultFont() {
+		return s_Data->DefaultFont;
+	}
+
+	Ref<Font> Renderer2D::GetFont(const std::string& path) {
+		if (path.empty())
+			return nullptr;
+
+		Ref<Font> font = s_Data->Fonts[path].lock();
+		if (!font) {
+			font = Font::Create(path);
+			s_Data->Fonts[path] = font;
+		}
+		return font;
+	}
 }
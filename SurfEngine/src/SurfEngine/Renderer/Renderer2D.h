@@ -3,6 +3,7 @@
 #include "FrameBuffer.h"
 #include "Texture.h"
 #include "Material.h"
+#include "Font.h"
 #include "VertexArray.h" 
 #include "SurfEngine/Scenes/Components.h"
 
@@ -11,6 +12,22 @@ namespace SurfEngine{
 
 	class Renderer2D
 	{
+	public:
+		// Reset every BeginScene, pixel counts are in render target pixels
+		struct Statistics {
+			uint32_t Sprites = 0;
+			// Sprites drawn with an outline mesh instead of the full quad
+			uint32_t MeshSprites = 0;
+			float QuadPixels = 0.0f;
+			float DrawnPixels = 0.0f;
+			uint32_t Glyphs = 0;
+			uint32_t TextDrawCalls = 0;
+			uint32_t Lights = 0;
+			// Light references summed over all screen tiles, what the fragments actually loop over
+			uint32_t LightTileEntries = 0;
+
+			float GetFillRateSavings() const { return QuadPixels > 0.0f ? 1.0f - DrawnPixels / QuadPixels : 0.0f; }
+		};
 	public:
 		static void Init();
 		static void Shutdown();
@@ -18,14 +35,24 @@ namespace SurfEngine{
 		static void BeginScene(const Camera* camera);
 		static void EndScene();
 
+		static const Statistics& GetStats();
+
 		static bool PushMaterial(const std::string& name, const Ref<Shader> shader);
 		static Ref<Material> GetMaterial(const std::string& name);
 
 		static void SetRenderTarget(Ref<Framebuffer> frameBuffer);
+		static const Ref<Framebuffer>& GetRenderTarget();
+		// Sizes set the output size, DynamicResolution renders the scene into a scaled down part of it
 		static void SetRenderSize(unsigned int x, unsigned int y);
 		static void ResizeRenderTarget(uint32_t width, uint32_t height);
 		static glm::vec2 GetRenderTargetSize();
+		// Size the frame is shown at, GetRenderTargetSize is the size the scene is drawn at
+		static glm::uvec2 GetOutputSize();
+		// What GetOutputAsTextureId shows, reset to the render target every BeginScene
+		static void SetOutput(const Ref<Framebuffer>& output);
+		static const Ref<Framebuffer>& GetOutput();
 		static uint32_t GetOutputAsTextureId();
+		static glm::vec2 GetOutputUVScale();
 		static void ClearRenderTarget();
 
 		static Ref<Texture2D> GetGizmo();
@@ -35,8 +62,32 @@ namespace SurfEngine{
 		static void DrawQuad(glm::mat4 transform);
 		static void DrawQuad(glm::mat4 transform, glm::vec4 color);
 
-		static void DrawQuad(glm::mat4 transform, Ref<SpriteRendererComponent> src);
-		static void DrawQuad(glm::mat4 transform, Ref<SpriteRendererComponent> src, int frame, int totalFrames);
+		// Sprite render data refers to textures by handle, the table holds each texture until its last handle is released
+		// Handle 0 is no texture
+		static uint32_t AcquireTextureHandle(const Ref<Texture2D>& texture);
+		static void ReleaseTextureHandle(uint32_t handle);
+		static const Ref<Texture2D>& GetTexture(uint32_t handle);
+
+		// Opaque draws front to back with depth writes, Translucent back to front against that depth
+		// Painter is plain draw order with depth off and is what everything outside the sprite passes uses
+		enum class SpritePass {
+			Painter = 0, Opaque = 1, Translucent = 2
+		};
+		static void SetSpritePass(SpritePass pass);
+		// True when the sprite can go in the opaque pass, its tint is opaque and its texture opaque or cutout
+		static bool IsSpriteOpaque(const SpriteRendererComponent& sprite);
+
+		// Animated sprites pick their frame on the GPU from SetTime and the animation's start time
+		// order in (0, 1] places the sprite inside its layer's depth slice, later sprites of a layer use larger values
+		static void DrawSprite(const glm::mat4& transform, const SpriteRenderData& sprite, const AnimationComponent* animation = nullptr, float order = 1.0f);
+		static void SetTime(float time);
+
+		// Lights submitted between BeginLighting and EndLighting light the sprites drawn after it
+		// EndLighting bins them into screen tiles so every fragment only evaluates the lights touching its tile
+		// Scenes that never call it stay unlit, global lights only add to the ambient term
+		static void BeginLighting(const glm::vec3& ambient);
+		static void SubmitLight(const glm::mat4& transform, const LightComponent& light);
+		static void EndLighting();
 
 		static void DrawCircle(glm::mat4 transform, glm::vec4 color);
 
@@ -47,5 +98,26 @@ namespace SurfEngine{
 		static void DrawGizmo(glm::mat4 transform, Ref<Texture2D> src, glm::vec4 color);
 
 		static void DrawBackgroundGrid(int amount);
+
+		// Draws the chunks that intersect the view, remeshing the ones edited since they were last drawn
+		static void DrawTilemap(const glm::mat4& transform, TilemapComponent& tilemap);
+
+		// Strings are laid out once and cached, their glyphs are queued and drawn per font by FlushText
+		// transform maps em units to world space, a null font uses the default font
+		static void DrawString(const std::string& text, const glm::mat4& transform, const glm::vec4& color, const Ref<Font>& font = nullptr, float kerning = 0.0f, float lineSpacing = 1.0f);
+		static void DrawString(const glm::mat4& transform, const TextComponent& text);
+		// Draws every queued glyph, one draw call per font, EndScene flushes whatever is left
+		static void FlushText();
+		static const Ref<Font>& GetDefaultFont();
+		// Fonts are loaded once per path so text using the same file shares an atlas and a draw call
+		static Ref<Font> GetFont(const std::string& path);
+
+		// One instanced draw for every live particle of the emitter, particles are already in world space
+		static void DrawParticles(ParticleEmitterComponent& emitter);
+
+		// Renders a layer once into world aligned tiles and composites it with one quad per visible tile
+		// The tiles are rebuilt when contentHash or the camera zoom changes, bounds is the layer's world
+		// rect (min x, min y, max x, max y) and drawContents issues the layer's draws
+		static void DrawStaticLayer(unsigned int layer, size_t contentHash, const glm::vec4& bounds, const std::function<void()>& drawContents);
 	};
 }
\ No newline at end of file
@@ -1,6 +1,19 @@
 #include "sepch.h"
 #include "RendererAPI.h"
 
+#include "SurfEngine/Platform/OpenGl/OpenGLRendererAPI.h"
+#include "SurfEngine/Platform/Software/SoftwareRendererAPI.h"
+
 namespace SurfEngine {
 	RendererAPI::API RendererAPI::s_API = RendererAPI::API::OpenGL;
+
+	RendererAPI* RendererAPI::Create() {
+		switch (s_API) {
+			case RendererAPI::API::None: SE_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::OpenGL: return new OpenGLRendererAPI;
+			case RendererAPI::API::Software: return new SoftwareRendererAPI;
+		}
+		SE_CORE_ASSERT(false, "Unknown RendererAPI specified!");
+		return nullptr;
+	}
 }
\ No newline at end of file
@@ -7,26 +7,51 @@ namespace SurfEngine {
 	class RendererAPI {
 	public:
 		enum class API {
-			None =0, OpenGL = 1
+			None =0, OpenGL = 1, Software = 2
 		};
 		enum class WireFrameMode {
 			Off = 0, On = 1
 		};
+		// AlphaToPremultiplied blends straight alpha sources into a target that is later composited as premultiplied
+		enum class BlendMode {
+			Alpha = 0, PremultipliedAlpha = 1, AlphaToPremultiplied = 2
+		};
+		// Test keeps the depth buffer read only, used for blended draws over an opaque pass
+		enum class DepthMode {
+			Off = 0, TestAndWrite = 1, Test = 2
+		};
 
 
 	public:
+		virtual ~RendererAPI() = default;
+
 		virtual void SetClearColor(const glm::vec4 color) = 0;
 		virtual void Clear() = 0;
 		virtual void EnableTextures() = 0;
 		virtual void EnableMSAA() = 0;
 		virtual void EnableDepth() = 0;
+		virtual void SetDepthMode(DepthMode mode) = 0;
 		virtual void EnableBlending() = 0;
+		virtual void SetBlendMode(BlendMode mode) = 0;
 		virtual void BindTextureId(int slot, uint32_t id) = 0;
 		virtual void SetWireFrameMode(WireFrameMode mode) = 0;
-		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray) = 0;
+		// indexCount 0 draws the whole index buffer
+		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0) = 0;
+		virtual void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t instanceCount) = 0;
 		virtual void DrawLine(const Ref<VertexArray>& vertexArray) = 0;
 
+		// Times the GPU work submitted between Begin and End, one measurement in flight per frame
+		// Results arrive a few frames late so reading them never waits on the GPU
+		virtual void BeginGPUTimer() = 0;
+		virtual void EndGPUTimer() = 0;
+		// Milliseconds of the newest finished measurement, negative until one has finished
+		virtual float GetGPUTime() = 0;
+
 		inline static API GetAPI() { return s_API; }
+		// Must be called before RenderCommand::Init and before any renderer resources are created
+		inline static void SetAPI(API api) { s_API = api; }
+
+		static RendererAPI* Create();
 	private:
 		static API s_API;
 	};
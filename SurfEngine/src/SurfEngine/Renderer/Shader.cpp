@@ -3,12 +3,14 @@
 
 #include "Renderer.h"
 #include "SurfEngine/Platform/OpenGl/OpenGLShader.h"
+#include "SurfEngine/Platform/Software/SoftwareShader.h"
 
 namespace SurfEngine {
 	Ref<Shader> Shader::Create(const std::string& filepath) {
 		switch (Renderer::GetAPI()) {
 		case RendererAPI::API::None: SE_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 		case RendererAPI::API::OpenGL: return std::make_shared<OpenGLShader>(filepath);
+		case RendererAPI::API::Software: return std::make_shared<SoftwareShader>(filepath);
 		}
 		SE_CORE_ASSERT(false, "Unknown RendererAPI specified!");
 		return nullptr;
@@ -18,6 +20,7 @@ namespace SurfEngine {
 		switch (Renderer::GetAPI()) {
 		case RendererAPI::API::None: SE_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 		case RendererAPI::API::OpenGL: return std::make_shared<OpenGLShader>(name, vertexSrc, fragmentSrc);
+		case RendererAPI::API::Software: return std::make_shared<SoftwareShader>(name, vertexSrc, fragmentSrc);
 		}
 		SE_CORE_ASSERT(false, "Unknown RendererAPI specified!");
 		return nullptr;
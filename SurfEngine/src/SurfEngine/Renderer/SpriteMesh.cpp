@@ -0,0 +1,163 @@
+#include "sepch.h"
+#include "SpriteMesh.h"
+
+#include <cfloat>
+
+namespace SurfEngine {
+
+	// Outlines covering more of the quad than this are not worth their extra vertices
+	static const float s_MaxCoverage = 0.9f;
+
+	namespace Utils {
+
+		static float Cross(const glm::vec2& a, const glm::vec2& b) {
+			return a.x * b.y - a.y * b.x;
+		}
+
+		// Andrew's monotone chain, counter clockwise and without collinear points
+		static std::vector<glm::vec2> ConvexHull(std::vector<glm::vec2> points) {
+			std::sort(points.begin(), points.end(), [](const glm::vec2& lhs, const glm::vec2& rhs) {
+				return lhs.x < rhs.x || (lhs.x == rhs.x && lhs.y < rhs.y);
+				});
+			points.erase(std::unique(points.begin(), points.end()), points.end());
+			if (points.size() < 3)
+				return {};
+
+			std::vector<glm::vec2> hull(points.size() * 2);
+			size_t k = 0;
+			for (size_t i = 0; i < points.size(); i++) {
+				while (k >= 2 && Cross(hull[k - 1] - hull[k - 2], points[i] - hull[k - 2]) <= 0.0f)
+					k--;
+				hull[k++] = points[i];
+			}
+			for (size_t i = points.size() - 1, lower = k + 1; i-- > 0;) {
+				while (k >= lower && Cross(hull[k - 1] - hull[k - 2], points[i] - hull[k - 2]) <= 0.0f)
+					k--;
+				hull[k++] = points[i];
+			}
+			hull.resize(k - 1);
+			return hull;
+		}
+
+		static float Area(const std::vector<glm::vec2>& polygon) {
+			float area = 0.0f;
+			for (size_t i = 0; i < polygon.size(); i++)
+				area += Cross(polygon[i], polygon[(i + 1) % polygon.size()]);
+			return fabsf(area) * 0.5f;
+		}
+
+		// Drops edges by extending both neighbours until they meet, so the outline only ever grows and
+		// keeps covering every visible texel. The edge adding the least area goes first and the new
+		// corner has to stay inside the frame, outside of it the texture coordinates would wrap
+		static bool ReduceOutline(std::vector<glm::vec2>& outline, uint32_t vertexBudget) {
+			while (outline.size() > vertexBudget) {
+				const size_t count = outline.size();
+				size_t best = count;
+				float bestArea = FLT_MAX;
+				glm::vec2 bestCorner;
+
+				for (size_t i = 0; i < count; i++) {
+					const glm::vec2& a = outline[(i + count - 1) % count];
+					const glm::vec2& b = outline[i];
+					const glm::vec2& c = outline[(i + 1) % count];
+					const glm::vec2& d = outline[(i + 2) % count];
+
+					glm::vec2 ab = b - a, dc = c - d;
+					float denominator = Cross(ab, dc);
+					if (fabsf(denominator) < 1e-9f)
+						continue;
+					float t = Cross(c - b, dc) / denominator;
+					float s = Cross(c - b, ab) / denominator;
+					if (t <= 0.0f || s <= 0.0f)
+						continue;
+
+					glm::vec2 corner = b + ab * t;
+					if (corner.x < -1e-4f || corner.y < -1e-4f || corner.x > 1.0f + 1e-4f || corner.y > 1.0f + 1e-4f)
+						continue;
+
+					float area = fabsf(Cross(corner - b, c - b)) * 0.5f;
+					if (area < bestArea) {
+						bestArea = area;
+						best = i;
+						bestCorner = glm::clamp(corner, 0.0f, 1.0f);
+					}
+				}
+
+				if (best == count)
+					return false;
+				outline[best] = bestCorner;
+				outline.erase(outline.begin() + (best + 1) % count);
+			}
+			return true;
+		}
+	}
+
+	Ref<SpriteMesh> SpriteMesh::Create(const Texture2D& texture, int frames, uint32_t vertexBudget) {
+		const Texture2D::AlphaCoverage& coverage = texture.GetAlphaCoverage();
+		if (coverage.Width == 0 || coverage.Height == 0 || vertexBudget < 3)
+			return nullptr;
+		frames = std::max(frames, 1);
+
+		//Outer corners of every row's visible span, frames of a sprite sheet are folded onto each other
+		std::vector<glm::vec2> points;
+		for (uint32_t row = 0; row < coverage.Height; row++) {
+			float minT = FLT_MAX, maxT = -FLT_MAX;
+			for (uint32_t column = 0; column < coverage.Width; column++) {
+				if (!coverage.Cells[(size_t)row * coverage.Width + column])
+					continue;
+
+				float u0 = (float)column / coverage.Width * frames;
+				float u1 = (float)(column + 1) / coverage.Width * frames;
+				int lastFrame = std::min((int)ceilf(u1) - 1, frames - 1);
+				for (int frame = (int)u0; frame <= lastFrame; frame++) {
+					minT = std::min(minT, std::max(u0 - frame, 0.0f));
+					maxT = std::max(maxT, std::min(u1 - frame, 1.0f));
+				}
+			}
+
+			if (minT > maxT)
+				continue;
+			float v0 = (float)row / coverage.Height;
+			float v1 = (float)(row + 1) / coverage.Height;
+			points.insert(points.end(), { { minT, v0 }, { minT, v1 }, { maxT, v0 }, { maxT, v1 } });
+		}
+
+		Ref<SpriteMesh> mesh = std::make_shared<SpriteMesh>();
+		mesh->m_Outline = Utils::ConvexHull(points);
+		if (mesh->m_Outline.empty()) {
+			mesh->m_Coverage = 0.0f;
+			return mesh;
+		}
+
+		if (!Utils::ReduceOutline(mesh->m_Outline, vertexBudget))
+			return nullptr;
+		mesh->m_Coverage = Utils::Area(mesh->m_Outline);
+		if (mesh->m_Coverage > s_MaxCoverage)
+			return nullptr;
+
+		//Same layout and texture mapping as the unit quad, x, y, z, texX, texY
+		std::vector<float> vertices;
+		vertices.reserve(mesh->m_Outline.size() * 5);
+		for (const glm::vec2& point : mesh->m_Outline)
+			vertices.insert(vertices.end(), { point.x - 0.5f, 0.5f - point.y, 0.0f, point.x, point.y });
+
+		std::vector<uint32_t> indices;
+		for (uint32_t i = 1; i + 1 < (uint32_t)mesh->m_Outline.size(); i++)
+			indices.insert(indices.end(), { 0, i, i + 1 });
+
+		Ref<VertexBuffer> vertexBuffer;
+		vertexBuffer.reset(VertexBuffer::Create(vertices.data(), (uint32_t)(vertices.size() * sizeof(float))));
+		vertexBuffer->SetLayout({
+			{ShaderDataType::Float3, "a_Position"},
+			{ShaderDataType::Float2, "a_TexCoord"},
+			});
+
+		std::shared_ptr<IndexBuffer> indexBuffer;
+		indexBuffer.reset(IndexBuffer::Create(indices.data(), (uint32_t)indices.size()));
+
+		mesh->m_VertexArray = VertexArray::Create();
+		mesh->m_VertexArray->AddVertexBuffer(vertexBuffer);
+		mesh->m_VertexArray->SetIndexBuffer(indexBuffer);
+		return mesh;
+	}
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include "Texture.h"
+#include "VertexArray.h"
+#include <glm/glm.hpp>
+
+namespace SurfEngine {
+
+	// Convex outline around the visible texels of a sprite, drawn in place of the full quad so the
+	// transparent area around irregular art is never rasterized
+	// Built once from the texture's alpha coverage, for sprite sheets the outline covers every frame
+	class SpriteMesh {
+	public:
+		// Returns nullptr when the outline would not save enough over a quad to be worth the extra vertices
+		static Ref<SpriteMesh> Create(const Texture2D& texture, int frames, uint32_t vertexBudget);
+
+		// nullptr when the texture has no visible texels at all
+		const Ref<VertexArray>& GetVertexArray() const { return m_VertexArray; }
+		uint32_t GetVertexCount() const { return (uint32_t)m_Outline.size(); }
+		// Area of the outline relative to the quad
+		float GetCoverage() const { return m_Coverage; }
+	private:
+		std::vector<glm::vec2> m_Outline;
+		Ref<VertexArray> m_VertexArray;
+		float m_Coverage = 1.0f;
+	};
+}
@@ -2,6 +2,7 @@
 #include "Texture.h"
 #include "Renderer.h"
 #include "SurfEngine/Platform/OpenGl/OpenGLTexture.h"
+#include "SurfEngine/Platform/Software/SoftwareTexture.h"
 
 namespace SurfEngine {
 	
@@ -9,9 +10,65 @@ namespace SurfEngine {
 		switch (Renderer::GetAPI()) {
 			case RendererAPI::API::None: SE_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 			case RendererAPI::API::OpenGL: return std::make_shared<OpenGLTexture2D>(path);
+			case RendererAPI::API::Software: return std::make_shared<SoftwareTexture2D>(path);
 		}
 		SE_CORE_ASSERT(false, "Unknown RendererAPI specified!");
 		return nullptr;
 	}
 
+	Ref<Texture2D> Texture2D::Create(uint32_t width, uint32_t height, Format format) {
+		switch (Renderer::GetAPI()) {
+			case RendererAPI::API::None: SE_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::OpenGL: return std::make_shared<OpenGLTexture2D>(width, height, format);
+			case RendererAPI::API::Software: return std::make_shared<SoftwareTexture2D>(width, height, format);
+		}
+		SE_CORE_ASSERT(false, "Unknown RendererAPI specified!");
+		return nullptr;
+	}
+
+	Texture2D::AlphaMode Texture2D::AnalyzeAlpha(const unsigned char* pixels, uint32_t pixelCount, int channels) {
+		if (channels != 4)
+			return AlphaMode::Opaque;
+
+		AlphaMode mode = AlphaMode::Opaque;
+		for (uint32_t i = 0; i < pixelCount; i++) {
+			unsigned char alpha = pixels[(size_t)i * 4 + 3];
+			if (alpha == 255)
+				continue;
+			if (alpha != 0)
+				return AlphaMode::Translucent;
+			mode = AlphaMode::Cutout;
+		}
+		return mode;
+	}
+
+	Texture2D::AlphaCoverage Texture2D::BuildAlphaCoverage(const unsigned char* pixels, uint32_t width, uint32_t height, int channels) {
+		const uint32_t maxCells = 64;
+
+		AlphaCoverage coverage;
+		coverage.Width = std::min(width, maxCells);
+		coverage.Height = std::min(height, maxCells);
+		coverage.Cells.assign((size_t)coverage.Width * coverage.Height, channels == 4 ? 0 : 1);
+		if (channels != 4)
+			return coverage;
+
+		//Texels straddling a cell border mark both cells so the mask never misses a visible texel
+		for (uint32_t y = 0; y < height; y++) {
+			const unsigned char* row = pixels + (size_t)y * width * 4;
+			uint32_t firstRow = y * coverage.Height / height;
+			uint32_t lastRow = ((y + 1) * coverage.Height - 1) / height;
+			for (uint32_t x = 0; x < width; x++) {
+				if (row[(size_t)x * 4 + 3] == 0)
+					continue;
+
+				uint32_t firstColumn = x * coverage.Width / width;
+				uint32_t lastColumn = ((x + 1) * coverage.Width - 1) / width;
+				for (uint32_t cellY = firstRow; cellY <= lastRow; cellY++)
+					for (uint32_t cellX = firstColumn; cellX <= lastColumn; cellX++)
+						coverage.Cells[(size_t)cellY * coverage.Width + cellX] = 1;
+			}
+		}
+		return coverage;
+	}
+
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <vector>
 #include "SurfEngine/Core/Core.h"
 
 namespace SurfEngine {
@@ -18,7 +19,35 @@ namespace SurfEngine {
 
 	class Texture2D : public Texture {
 	public:
+		// RGBA32F textures carry shader data, they use nearest filtering and are read with texelFetch
+		enum class Format {
+			RGBA8 = 0, RGBA32F = 1
+		};
+
+		// Cutout textures only use fully opaque or fully transparent texels, so they can be drawn with an alpha test
+		enum class AlphaMode {
+			Opaque = 0, Cutout = 1, Translucent = 2
+		};
+
+		// Low resolution mask of the cells holding at least one visible texel, rows follow the v coordinate
+		struct AlphaCoverage {
+			uint32_t Width = 0, Height = 0;
+			std::vector<uint8_t> Cells;
+		};
+
+		// Measured from the pixels when the texture is loaded, unloaded textures are Translucent
+		virtual AlphaMode GetAlphaMode() const = 0;
+		virtual const AlphaCoverage& GetAlphaCoverage() const = 0;
+
+		// Uploads pixels in the texture's format, size is in bytes and has to cover the whole texture
+		virtual void SetData(void* data, uint32_t size) = 0;
+
 		static Ref<Texture2D> Create(const std::string& path);
+		// Empty texture with clamped edges filled through SetData, RGBA8 textures use linear filtering
+		static Ref<Texture2D> Create(uint32_t width, uint32_t height, Format format = Format::RGBA8);
+	protected:
+		static AlphaMode AnalyzeAlpha(const unsigned char* pixels, uint32_t pixelCount, int channels);
+		static AlphaCoverage BuildAlphaCoverage(const unsigned char* pixels, uint32_t width, uint32_t height, int channels);
 	};
 
 
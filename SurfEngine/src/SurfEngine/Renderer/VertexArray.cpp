@@ -4,12 +4,14 @@
 #include "Renderer.h"
 #include "SurfEngine/Platform/OpenGl/OpenGLVertexArray.h"
 #include "SurfEngine/Platform/OpenGl/OpenGLBuffer.h"
+#include "SurfEngine/Platform/Software/SoftwareVertexArray.h"
 
 namespace SurfEngine {
 	Ref<VertexArray> VertexArray::Create() {
 		switch (Renderer::GetAPI()) {
 			case RendererAPI::API::None: SE_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 			case RendererAPI::API::OpenGL: return std::make_shared<OpenGLVertexArray>();
+			case RendererAPI::API::Software: return std::make_shared<SoftwareVertexArray>();
 		}
 		SE_CORE_ASSERT(false, "Unknown RendererAPI specified!");
 		return nullptr;
@@ -6,6 +6,9 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include "SurfEngine/Core/UUID.h"
 #include "SurfEngine/Renderer/Texture.h"
+#include "SurfEngine/Renderer/VertexArray.h"
+#include "SurfEngine/Renderer/ParticlePool.h"
+#include "SurfEngine/Renderer/Font.h"
 #include "SurfEngine/Scenes/ScriptableObject.h"
 #include "SurfEngine/Core/Input.h"
 #include "SceneCamera.h"
@@ -44,13 +47,34 @@ namespace SurfEngine{
 
 	};
 	
+	// Rotations only turn around z and scales are accumulated apart from them, so a world transform is a
+	// 2D rigid transform with a height and a per axis scale
+	struct WorldTransform {
+		glm::vec3 Position = { 0.0f, 0.0f, 0.0f };
+		// Cosine and sine of the accumulated rotation
+		glm::vec2 Rotation = { 1.0f, 0.0f };
+		glm::vec3 Scale = { 1.0f, 1.0f, 1.0f };
+
+		static WorldTransform Compose(const WorldTransform& parent, const glm::vec3& translation, const glm::vec2& rotation, const glm::vec3& scale) {
+			const glm::vec2& r = parent.Rotation;
+			WorldTransform world;
+			world.Position = parent.Position + glm::vec3(r.x * translation.x - r.y * translation.y, r.y * translation.x + r.x * translation.y, translation.z);
+			world.Rotation = { r.x * rotation.x - r.y * rotation.y, r.y * rotation.x + r.x * rotation.y };
+			world.Scale = parent.Scale * scale;
+			return world;
+		}
+	};
+
 	struct TransformComponent
 	{
 		Object gameObject;
-		TransformComponent* parent = nullptr;
-		std::vector<TransformComponent*> children = std::vector<TransformComponent*>();
-	
+		// Hierarchy links are entity handles rather than pointers, so transforms can be moved around in storage
+		// The children are an intrusive list threaded through their sibling links, in the order they were added
+		entt::entity Parent = entt::null;
+		entt::entity FirstChild = entt::null;
+		entt::entity NextSibling = entt::null;
 
+		// Write through the setters, they invalidate the cached world matrices of this transform and its children
 		glm::vec3 Translation = { 0.0f, 0.0f, 0.0f };
 		glm::vec3 Rotation = { 0.0f, 0.0f, 0.0f };
 		glm::vec3 Scale = { 1.0f, 1.0f, 1.0f };
@@ -65,105 +89,167 @@ namespace SurfEngine{
 			: Translation(translation) {}
 
 
-		glm::mat4 GetTranScale() const {
-			glm::mat4 parent_scale = glm::mat4(1.0f);
-			if (parent) {
-				parent_scale = parent->GetTranScale();
-			}
-			return parent_scale * glm::scale(glm::mat4(1.0f), Scale);
-		}
+		void SetTranslation(const glm::vec3& translation) { Translation = translation; MarkDirty(); }
+		void SetRotation(const glm::vec3& rotation) { Rotation = rotation; MarkDirty(); }
+		void SetScale(const glm::vec3& scale) { Scale = scale; MarkDirty(); }
 
-		glm::mat4 GetTranRot() const {
-			glm::mat4 parent_transform = glm::mat4(1.0f);
-			if (parent) {
-				parent_transform = parent->GetTranRot();
-			}
+		// A dirty transform always has dirty children, so an already dirty one can stop here
+		void MarkDirty() {
+			if (m_Dirty)
+				return;
+			m_Dirty = true;
+			ForEachChild([](TransformComponent& child) { child.MarkDirty(); });
+		}
 
-			glm::mat4 transform = glm::translate(glm::mat4(1.0f), Translation);
-			transform *= glm::rotate(glm::mat4(1.0f), glm::radians(Rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
-			return  parent_transform * transform;
+		TransformComponent* GetParent() const {
+			return Parent != entt::null ? &Resolve(Parent) : nullptr;
 		}
 
-		glm::mat4 GetTransform() const
-		{
-			glm::mat4 parent_transform = glm::mat4(1.0f);
-			if (parent) {
-				parent_transform = parent->GetTranRot();
+		bool HasChildren() const { return FirstChild != entt::null; }
+
+		// Func may unlink or destroy the child it is given, the next one is read before the call
+		template<typename Func>
+		void ForEachChild(Func func) const {
+			entt::registry& registry = GetRegistry();
+			for (entt::entity child = FirstChild; child != entt::null;) {
+				TransformComponent& tc = registry.get<TransformComponent>(child);
+				entt::entity next = tc.NextSibling;
+				func(tc);
+				child = next;
 			}
+		}
 
-			glm::mat4 transform = glm::translate(glm::mat4(1.0f), Translation);
-			transform *= glm::rotate(glm::mat4(1.0f), glm::radians(Rotation.z), glm::vec3(0.0f,0.0f,1.0f));
-
-			transform = parent_transform * transform;
-			transform *= GetTranScale();
-
-			return  transform ;
+		// Kept current by the scene's TransformHierarchy each frame, rebuilt here when read while dirty
+		const WorldTransform& GetWorld() const { UpdateWorld(); return m_World; }
 
+		// Parent translation and rotation chain, scales are accumulated separately and applied last
+		glm::mat4 GetTranScale() const {
+			const WorldTransform& world = GetWorld();
+			return glm::scale(glm::mat4(1.0f), world.Scale);
 		}
 
-		glm::mat4 GetTransformLocalScale() const
-		{
-			glm::mat4 parent_transform = glm::mat4(1.0f);
-			if (parent) {
-				parent_transform = parent->GetTranRot();
-			}
+		glm::mat4 GetTranRot() const {
+			const WorldTransform& world = GetWorld();
+			return ToMatrix(world, glm::vec3(1.0f));
+		}
 
-			glm::mat4 transform = glm::translate(glm::mat4(1.0f), Translation);
-			transform *= glm::rotate(glm::mat4(1.0f), glm::radians(Rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
+		glm::mat4 GetTransform() const {
+			const WorldTransform& world = GetWorld();
+			return ToMatrix(world, world.Scale);
+		}
 
-			transform = parent_transform * transform;
-			transform *= glm::scale(glm::mat4(1.0f), Scale);
+		// The cached world matrix as the last TransformHierarchy update left it, never rebuilt here
+		// Safe to read from several threads at once, unlike the getters above
+		glm::mat4 GetCachedTransform() const {
+			SE_CORE_ASSERT(!m_Dirty, "Transform read before the hierarchy update");
+			return ToMatrix(m_World, m_World.Scale);
+		}
 
-			return  transform;
+		// World transform with only this transform's own scale
+		glm::mat4 GetTransformLocalScale() const {
+			return ToMatrix(GetWorld(), Scale);
 		}
 
 		bool HasSuperChild(TransformComponent* tc) {
-			if (tc->parent) {
-				if (tc->parent == this) { return true; }
-				return HasSuperChild(tc->parent);
+			for (TransformComponent* t = tc->GetParent(); t; t = t->GetParent()) {
+				if (t == this) { return true; }
 			}
 			return false;
 		}
 
+		// Appends tc to the children, taking it from its current parent first
 		void AddChild(TransformComponent* tc) {
-			if (tc) {
-				children.push_back(tc);
-				tc->parent = this;
+			if (!tc || tc == this)
+				return;
+			if (TransformComponent* parent = tc->GetParent())
+				parent->RemoveChild(tc);
+
+			tc->Parent = (entt::entity)gameObject;
+			if (FirstChild == entt::null) {
+				FirstChild = (entt::entity)tc->gameObject;
 			}
+			else {
+				TransformComponent* last = &Resolve(FirstChild);
+				while (last->NextSibling != entt::null)
+					last = &Resolve(last->NextSibling);
+				last->NextSibling = (entt::entity)tc->gameObject;
+			}
+			tc->MarkDirty();
 		}
 
 		void RemoveChild(TransformComponent* tc) {
-			for (int i = 0; i < children.size(); i++) {
-				if (children[i] == tc) {
-					children[i]->parent = nullptr;
-					children.erase(children.begin() + i);
-					break;
+			entt::entity child = (entt::entity)tc->gameObject;
+			if (tc->Parent != (entt::entity)gameObject)
+				return;
+
+			if (FirstChild == child) {
+				FirstChild = tc->NextSibling;
+			}
+			else {
+				for (entt::entity previous = FirstChild; previous != entt::null;) {
+					TransformComponent& t = Resolve(previous);
+					if (t.NextSibling == child) {
+						t.NextSibling = tc->NextSibling;
+						break;
+					}
+					previous = t.NextSibling;
 				}
 			}
+			tc->Parent = entt::null;
+			tc->NextSibling = entt::null;
+			tc->MarkDirty();
 		}
 	
 		void SetParent(TransformComponent* tc) {
-			if (tc) {
-				if (HasSuperChild(tc)) {
-					TransformComponent* t = tc;
-					while (t->parent != this) {
-						t = t->parent;
-					}
-					RemoveChild(t);
-					t->parent = this->parent;
-					if (t->parent) { t->parent->AddChild(t); }
-				}
+			if (tc == this)
+				return;
+
+			//Parenting to one of our own descendants first lifts the branch holding it up to our parent
+			if (tc && HasSuperChild(tc)) {
+				TransformComponent* t = tc;
+				while (t->Parent != (entt::entity)gameObject)
+					t = t->GetParent();
+				TransformComponent* parent = GetParent();
+				RemoveChild(t);
+				if (parent) { parent->AddChild(t); }
 			}
-			
+
 			//Remove THIS from parent
-			if (parent) {
+			if (TransformComponent* parent = GetParent())
 				parent->RemoveChild(this);
-			}
-			
-			parent = tc;
-			if(tc)
-				tc->children.push_back(this);
+
+			if (tc)
+				tc->AddChild(this);
+			MarkDirty();
+		}
+
+	private:
+		void UpdateWorld() const {
+			if (!m_Dirty)
+				return;
+			float radians = glm::radians(Rotation.z);
+			glm::vec2 rotation = { std::cos(radians), std::sin(radians) };
+			TransformComponent* parent = GetParent();
+			m_World = WorldTransform::Compose(parent ? parent->GetWorld() : WorldTransform(), Translation, rotation, Scale);
+			m_Dirty = false;
+		}
+
+		entt::registry& GetRegistry() const { return *gameObject.GetScene()->GetRegistry(); }
+		TransformComponent& Resolve(entt::entity entity) const { return GetRegistry().get<TransformComponent>(entity); }
+
+		// Translation and z rotation of world followed by scale
+		static glm::mat4 ToMatrix(const WorldTransform& world, const glm::vec3& scale) {
+			const glm::vec2& r = world.Rotation;
+			return glm::mat4(
+				r.x * scale.x, r.y * scale.x, 0.0f, 0.0f,
+				-r.y * scale.y, r.x * scale.y, 0.0f, 0.0f,
+				0.0f, 0.0f, scale.z, 0.0f,
+				world.Position.x, world.Position.y, world.Position.z, 1.0f);
 		}
+
+		mutable WorldTransform m_World;
+		mutable bool m_Dirty = true;
+		friend class TransformHierarchy;
 	};
 
 	struct SpriteRendererComponent {
@@ -174,10 +260,13 @@ namespace SurfEngine{
 		Ref<Texture2D> Texture;
 		std::string Texture_Path = "";
 		bool reflective = false;
-		int currFrame = 1;
-		int totalFrames = 1;
 		glm::vec2 scaling = { 1.0f, 1.0f};
 		glm::vec2 offset  = { 0.0f, 0.0f};
+		// Corners of the outline mesh drawn instead of the quad, below 3 always draws the quad
+		unsigned int MeshVertexBudget = 8;
+		// Tangent space normals laid out like Texture, only used once the scene has lights
+		Ref<Texture2D> NormalMap;
+		std::string NormalMap_Path = "";
 
 		SpriteRendererComponent() = default;
 		SpriteRendererComponent(const SpriteRendererComponent&) = default;
@@ -185,6 +274,169 @@ namespace SurfEngine{
 			: Color(color) {}
 	};
 
+	// What the draw loop reads of a sprite, kept next to every SpriteRendererComponent by its scene
+	// Paths and texture references stay in SpriteRendererComponent, textures here are Renderer2D handles
+	// The scene acquires and releases the handles, so this is never copied between objects
+	struct SpriteRenderData {
+		enum Flag : uint32_t {
+			FlipX = 1 << 0,
+			// Opaque tint and an opaque or cutout texture, see Renderer2D::IsSpriteOpaque
+			Opaque = 1 << 1,
+			Cutout = 1 << 2
+		};
+
+		glm::vec4 Color = { 1.0f, 1.0f, 1.0f, 1.0f };
+		glm::vec2 Scaling = { 1.0f, 1.0f };
+		glm::vec2 Offset = { 0.0f, 0.0f };
+		uint32_t Layer = 0;
+		uint32_t Flags = 0;
+		uint32_t Texture = 0;
+		uint32_t NormalMap = 0;
+		uint32_t MeshVertexBudget = 0;
+	};
+	static_assert(sizeof(SpriteRenderData) <= 64, "SpriteRenderData should fit a cache line");
+
+	// Tile indices into a tileset texture, stored and meshed in fixed size chunks
+	// Tile (x, y) covers [x, x + 1] x [y, y + 1] in object space, -1 marks an empty tile
+	struct TilemapComponent {
+		static const int ChunkSize = 32;
+
+		struct Chunk {
+			std::array<int, ChunkSize * ChunkSize> Tiles;
+			uint32_t TileCount = 0;
+
+			//Dont Save
+			Ref<VertexArray> Mesh;
+			bool Dirty = true;
+
+			Chunk() { Tiles.fill(-1); }
+		};
+
+		//Save
+		std::string Tileset_Path = "";
+		int Columns = 1;
+		int Rows = 1;
+		unsigned int Layer = 0;
+		glm::vec4 Color{ 1.0f,1.0f,1.0f,1.0f };
+		std::unordered_map<uint64_t, Chunk> Chunks;
+
+		//Dont Save
+		Ref<Texture2D> Tileset;
+
+		TilemapComponent() = default;
+		TilemapComponent(const TilemapComponent&) = default;
+
+		static uint64_t GetChunkKey(int chunkX, int chunkY) {
+			return ((uint64_t)(uint32_t)chunkX << 32) | (uint32_t)chunkY;
+		}
+
+		static int FloorDiv(int value, int divisor) {
+			return value >= 0 ? value / divisor : (value - divisor + 1) / divisor;
+		}
+
+		int GetTile(int x, int y) const {
+			int chunkX = FloorDiv(x, ChunkSize), chunkY = FloorDiv(y, ChunkSize);
+			auto it = Chunks.find(GetChunkKey(chunkX, chunkY));
+			if (it == Chunks.end())
+				return -1;
+			return it->second.Tiles[(y - chunkY * ChunkSize) * ChunkSize + (x - chunkX * ChunkSize)];
+		}
+
+		void SetTile(int x, int y, int tile) {
+			int chunkX = FloorDiv(x, ChunkSize), chunkY = FloorDiv(y, ChunkSize);
+			uint64_t key = GetChunkKey(chunkX, chunkY);
+			auto it = Chunks.find(key);
+			if (it == Chunks.end()) {
+				if (tile < 0)
+					return;
+				it = Chunks.emplace(key, Chunk()).first;
+			}
+
+			Chunk& chunk = it->second;
+			int& current = chunk.Tiles[(y - chunkY * ChunkSize) * ChunkSize + (x - chunkX * ChunkSize)];
+			tile = tile < 0 ? -1 : tile;
+			if (current == tile)
+				return;
+
+			chunk.TileCount += (tile >= 0) - (current >= 0);
+			current = tile;
+			chunk.Dirty = true;
+			if (chunk.TileCount == 0)
+				Chunks.erase(it);
+		}
+
+		// Call after changing the tileset or its grid so every chunk is remeshed
+		void Invalidate() {
+			for (auto& [key, chunk] : Chunks)
+				chunk.Dirty = true;
+		}
+	};
+
+	struct ParticleEmitterComponent {
+		//Save
+		uint32_t MaxParticles = 10000;
+		float EmissionRate = 500.0f;
+		float Lifetime = 1.0f;
+		float LifetimeVariation = 0.25f;
+		glm::vec2 Velocity = { 0.0f, -2.0f };
+		glm::vec2 VelocityVariation = { 1.0f, 1.0f };
+		glm::vec2 Gravity = { 0.0f, 0.0f };
+		float Drag = 0.0f;
+		glm::vec4 ColorBegin{ 1.0f,1.0f,1.0f,1.0f };
+		glm::vec4 ColorEnd{ 1.0f,1.0f,1.0f,0.0f };
+		float SizeBegin = 0.25f;
+		float SizeEnd = 0.0f;
+		unsigned int Layer = 0;
+		std::string Texture_Path = "";
+
+		//Dont Save
+		Ref<Texture2D> Texture;
+		Ref<ParticlePool> Pool;
+		bool Emitting = true;
+
+		ParticleEmitterComponent() = default;
+		ParticleEmitterComponent(const ParticleEmitterComponent&) = default;
+	};
+
+	// Text drawn in object space, one unit per em, starting at the baseline of the first line
+	struct TextComponent {
+		//Save
+		std::string Text = "Text";
+		std::string Font_Path = "";
+		glm::vec4 Color{ 1.0f,1.0f,1.0f,1.0f };
+		float Kerning = 0.0f;
+		float LineSpacing = 1.0f;
+		unsigned int Layer = 0;
+
+		//Dont Save, nullptr uses the default font
+		Ref<Font> FontAsset;
+
+		TextComponent() = default;
+		TextComponent(const TextComponent&) = default;
+	};
+
+	// Scenes without lights are drawn unlit, once one exists sprites only receive the light that reaches them
+	// Spot lights point along the object's x axis, global lights light everything evenly
+	struct LightComponent {
+		enum class Type {
+			Point = 0, Spot = 1, Global = 2
+		};
+
+		//Save
+		Type LightType = Type::Point;
+		glm::vec3 Color{ 1.0f,1.0f,1.0f };
+		float Intensity = 1.0f;
+		float Radius = 5.0f;
+		// Distance above the sprites, lower lights graze normal mapped sprites at flatter angles
+		float Height = 1.0f;
+		// Full cone angles in degrees
+		float InnerAngle = 30.0f;
+		float OuterAngle = 45.0f;
+
+		LightComponent() = default;
+		LightComponent(const LightComponent&) = default;
+	};
+
 	struct CameraComponent {
 		SceneCamera Camera;
 
@@ -197,20 +449,32 @@ namespace SurfEngine{
 		AnimationComponent() = default;
 		AnimationComponent(const AnimationComponent&) = default;
 
-		void Tick(Timestep ts) {
-			if (!play) { return; }
+		// Frames are picked on the GPU from the scene time, these only change the playback state
+		void Play(float time) {
+			if (!play)
+				startTime = time;
+			play = true;
+		}
 
-			timer += ts;
-			
-			if (timer > (1.0f / fps)) {
-				timer = 0.0f;
-				currframe++;
-			}
-			
-			if (currframe > frames) {
-				play = loop;
-				currframe = 1;
-			}
+		void Stop(float time) {
+			currframe = GetFrame(time);
+			play = false;
+		}
+
+		void SetFrame(int frame, float time) {
+			currframe = frame;
+			startTime = time;
+		}
+
+		// Mirrors the sprite shader, finished animations that dont loop rest on the first frame
+		int GetFrame(float time) const {
+			if (!play || frames <= 0 || fps <= 0)
+				return currframe;
+
+			int frame = currframe - 1 + (int)std::floor(std::max(time - startTime, 0.0f) * fps);
+			if (loop)
+				return frame % frames + 1;
+			return frame < frames ? frame + 1 : 1;
 		}
 
 		//Save
@@ -222,7 +486,7 @@ namespace SurfEngine{
 		//Dont Save
 		bool play = true;
 		int currframe = 1;
-		float timer = 0.0f;
+		float startTime = 0.0f;
 	};
 
 	struct ScriptComponent {
@@ -236,6 +500,8 @@ namespace SurfEngine{
 
 		ScriptClass monoclass = {};
 		MonoObject* script_class_instance = nullptr;
+		// Looked up once when the scene starts, null when the script has no OnFixedUpdate
+		MonoMethod* fixed_update_method = nullptr;
 	};
 
 	struct RigidbodyComponent
@@ -246,6 +512,11 @@ namespace SurfEngine{
 
 		// Storage for runtime
 		void* RuntimeBody = nullptr;
+		// Poses after the last two fixed steps, rendering interpolates between them
+		glm::vec2 PreviousPosition = { 0.0f, 0.0f };
+		glm::vec2 CurrentPosition = { 0.0f, 0.0f };
+		float PreviousAngle = 0.0f;
+		float CurrentAngle = 0.0f;
 
 		RigidbodyComponent() = default;
 		RigidbodyComponent(const RigidbodyComponent&) = default;
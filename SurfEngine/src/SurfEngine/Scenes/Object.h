@@ -25,12 +25,14 @@ namespace SurfEngine {
 		template<typename T, typename... Args>
 		T& AddComponent(Args&&... args) {
 			SE_CORE_ASSERT(!HasComponent<T>(), "Object already has component!");
+			m_Scene->MarkDirty();
 			return m_Scene->m_Registry.emplace<T>(m_ObjectHandle, std::forward<Args>(args)...);
 		}
 
 		template <typename T>
 		void RemoveComponent(){
 			SE_CORE_ASSERT(HasComponent<T>(), "Object does not have component!");
+			m_Scene->MarkDirty();
 			m_Scene->m_Registry.remove<T>(m_ObjectHandle);
 		}
 
@@ -48,7 +50,7 @@ namespace SurfEngine {
 			return !(*this == other);
 		}
 
-		Scene* GetScene() {
+		Scene* GetScene() const {
 			return m_Scene;
 		}
 
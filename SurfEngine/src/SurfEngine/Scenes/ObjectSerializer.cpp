@@ -3,6 +3,7 @@
 #include "SceneSerializer.h"
 #include "Components.h"
 #include "AssetSerializer.h"
+#include "SurfEngine/Renderer/Renderer2D.h"
 
 #include <fstream>
 #include <yaml-cpp/yaml.h>
@@ -159,18 +160,19 @@ namespace SurfEngine {
 			out << YAML::Key << "Rotation" << YAML::Value << tc.Rotation;
 			out << YAML::Key << "Scale" << YAML::Value << tc.Scale;
 			uint64_t parent = 0;
-			if (tc.parent)
+			if (TransformComponent* parentTransform = tc.GetParent())
 			{
-				parent = (uint64_t)tc.parent->gameObject.GetComponent<TagComponent>().uuid;
+				parent = (uint64_t)parentTransform->gameObject.GetComponent<TagComponent>().uuid;
 			}
 			out << YAML::Key << "Parent" << YAML::Value << parent;
-			out << YAML::Key << "ChildCount" << YAML::Value << tc.children.size();
 
-			for (int i = 0; i < tc.children.size(); i++)
+			std::vector<uint64_t> children;
+			tc.ForEachChild([&](TransformComponent& child) { children.push_back((uint64_t)child.gameObject.GetComponent<TagComponent>().uuid); });
+			out << YAML::Key << "ChildCount" << YAML::Value << children.size();
+
+			for (int i = 0; i < children.size(); i++)
 			{
-				uint64_t child = 0;
-				child = (uint64_t)tc.children[i]->gameObject.GetComponent<TagComponent>().uuid;
-				out << YAML::Key << "Child" + std::to_string(i) << YAML::Value << child;
+				out << YAML::Key << "Child" + std::to_string(i) << YAML::Value << children[i];
 			}
 
 			out << YAML::EndMap; // TransformComponent
@@ -190,10 +192,103 @@ namespace SurfEngine {
 			out << YAML::Key << "Reflective" << YAML::Value << spriteRendererComponent.reflective;
 			out << YAML::Key << "Scaling" << YAML::Value << spriteRendererComponent.scaling;
 			out << YAML::Key << "Offset" << YAML::Value << spriteRendererComponent.offset;
+			out << YAML::Key << "MeshVertexBudget" << YAML::Value << spriteRendererComponent.MeshVertexBudget;
+			out << YAML::Key << "NormalMap_Path" << YAML::Value << spriteRendererComponent.NormalMap_Path;
 
 			out << YAML::EndMap; // SpriteRendererComponent
 		}
 
+		if (object.HasComponent<TilemapComponent>())
+		{
+			out << YAML::Key << "TilemapComponent";
+			out << YAML::BeginMap; // TilemapComponent
+
+			auto& tilemapComponent = object.GetComponent<TilemapComponent>();
+			out << YAML::Key << "Tileset_Path" << YAML::Value << tilemapComponent.Tileset_Path;
+			out << YAML::Key << "Columns" << YAML::Value << tilemapComponent.Columns;
+			out << YAML::Key << "Rows" << YAML::Value << tilemapComponent.Rows;
+			out << YAML::Key << "Layer" << YAML::Value << tilemapComponent.Layer;
+			out << YAML::Key << "Color" << YAML::Value << tilemapComponent.Color;
+			out << YAML::Key << "ChunkSize" << YAML::Value << TilemapComponent::ChunkSize;
+
+			//Chunks are run length encoded as count, tile pairs
+			out << YAML::Key << "Chunks" << YAML::Value << YAML::BeginSeq;
+			for (auto& [key, chunk] : tilemapComponent.Chunks) {
+				out << YAML::BeginMap;
+				out << YAML::Key << "Coord" << YAML::Value << YAML::Flow << YAML::BeginSeq << (int)(uint32_t)(key >> 32) << (int)(uint32_t)key << YAML::EndSeq;
+				out << YAML::Key << "Runs" << YAML::Value << YAML::Flow << YAML::BeginSeq;
+				for (size_t i = 0; i < chunk.Tiles.size();) {
+					size_t run = 1;
+					while (i + run < chunk.Tiles.size() && chunk.Tiles[i + run] == chunk.Tiles[i])
+						run++;
+					out << run << chunk.Tiles[i];
+					i += run;
+				}
+				out << YAML::EndSeq;
+				out << YAML::EndMap;
+			}
+			out << YAML::EndSeq;
+
+			out << YAML::EndMap; // TilemapComponent
+		}
+
+		if (object.HasComponent<ParticleEmitterComponent>())
+		{
+			out << YAML::Key << "ParticleEmitterComponent";
+			out << YAML::BeginMap; // ParticleEmitterComponent
+
+			auto& pec = object.GetComponent<ParticleEmitterComponent>();
+			out << YAML::Key << "MaxParticles" << YAML::Value << pec.MaxParticles;
+			out << YAML::Key << "EmissionRate" << YAML::Value << pec.EmissionRate;
+			out << YAML::Key << "Lifetime" << YAML::Value << pec.Lifetime;
+			out << YAML::Key << "LifetimeVariation" << YAML::Value << pec.LifetimeVariation;
+			out << YAML::Key << "Velocity" << YAML::Value << pec.Velocity;
+			out << YAML::Key << "VelocityVariation" << YAML::Value << pec.VelocityVariation;
+			out << YAML::Key << "Gravity" << YAML::Value << pec.Gravity;
+			out << YAML::Key << "Drag" << YAML::Value << pec.Drag;
+			out << YAML::Key << "ColorBegin" << YAML::Value << pec.ColorBegin;
+			out << YAML::Key << "ColorEnd" << YAML::Value << pec.ColorEnd;
+			out << YAML::Key << "SizeBegin" << YAML::Value << pec.SizeBegin;
+			out << YAML::Key << "SizeEnd" << YAML::Value << pec.SizeEnd;
+			out << YAML::Key << "Layer" << YAML::Value << pec.Layer;
+			out << YAML::Key << "Texture_Path" << YAML::Value << pec.Texture_Path;
+
+			out << YAML::EndMap; // ParticleEmitterComponent
+		}
+
+		if (object.HasComponent<TextComponent>())
+		{
+			out << YAML::Key << "TextComponent";
+			out << YAML::BeginMap; // TextComponent
+
+			auto& tc = object.GetComponent<TextComponent>();
+			out << YAML::Key << "Text" << YAML::Value << tc.Text;
+			out << YAML::Key << "Font_Path" << YAML::Value << tc.Font_Path;
+			out << YAML::Key << "Color" << YAML::Value << tc.Color;
+			out << YAML::Key << "Kerning" << YAML::Value << tc.Kerning;
+			out << YAML::Key << "LineSpacing" << YAML::Value << tc.LineSpacing;
+			out << YAML::Key << "Layer" << YAML::Value << tc.Layer;
+
+			out << YAML::EndMap; // TextComponent
+		}
+
+		if (object.HasComponent<LightComponent>())
+		{
+			out << YAML::Key << "LightComponent";
+			out << YAML::BeginMap; // LightComponent
+
+			auto& lc = object.GetComponent<LightComponent>();
+			out << YAML::Key << "Type" << YAML::Value << (int)lc.LightType;
+			out << YAML::Key << "Color" << YAML::Value << lc.Color;
+			out << YAML::Key << "Intensity" << YAML::Value << lc.Intensity;
+			out << YAML::Key << "Radius" << YAML::Value << lc.Radius;
+			out << YAML::Key << "Height" << YAML::Value << lc.Height;
+			out << YAML::Key << "InnerAngle" << YAML::Value << lc.InnerAngle;
+			out << YAML::Key << "OuterAngle" << YAML::Value << lc.OuterAngle;
+
+			out << YAML::EndMap; // LightComponent
+		}
+
 		if (object.HasComponent<AnimationComponent>())
 		{
 			out << YAML::Key << "AnimationComponent";
@@ -315,9 +410,9 @@ namespace SurfEngine {
 				{
 					// Entities always have transforms
 					auto& tc = deserializedObject.GetComponent<TransformComponent>();
-					tc.Translation = transformComponent["Translation"].as<glm::vec3>();
-					tc.Rotation = transformComponent["Rotation"].as<glm::vec3>();
-					tc.Scale = transformComponent["Scale"].as<glm::vec3>();
+					tc.SetTranslation(transformComponent["Translation"].as<glm::vec3>());
+					tc.SetRotation(transformComponent["Rotation"].as<glm::vec3>());
+					tc.SetScale(transformComponent["Scale"].as<glm::vec3>());
 				}
 
 
@@ -332,8 +427,93 @@ namespace SurfEngine {
 					src.reflective		= spriteRendererComponent["Reflective"].as<bool>();
 					src.scaling			= spriteRendererComponent["Scaling"].as<glm::vec2>();
 					src.offset			= spriteRendererComponent["Offset"].as<glm::vec2>();
+					if (spriteRendererComponent["MeshVertexBudget"])
+						src.MeshVertexBudget = spriteRendererComponent["MeshVertexBudget"].as<unsigned int>();
 					if (!src.Texture_Path.empty())
 						src.Texture = Texture2D::Create(src.Texture_Path);
+					if (spriteRendererComponent["NormalMap_Path"])
+						src.NormalMap_Path = spriteRendererComponent["NormalMap_Path"].as<std::string>();
+					if (!src.NormalMap_Path.empty())
+						src.NormalMap = Texture2D::Create(src.NormalMap_Path);
+				}
+
+				auto tilemapComponent = object["TilemapComponent"];
+				if (tilemapComponent)
+				{
+					auto& tmc			= deserializedObject.AddComponent<TilemapComponent>();
+					tmc.Tileset_Path	= tilemapComponent["Tileset_Path"].as<std::string>();
+					tmc.Columns			= tilemapComponent["Columns"].as<int>();
+					tmc.Rows			= tilemapComponent["Rows"].as<int>();
+					tmc.Layer			= tilemapComponent["Layer"].as<unsigned int>();
+					tmc.Color			= tilemapComponent["Color"].as<glm::vec4>();
+					if (!tmc.Tileset_Path.empty())
+						tmc.Tileset = Texture2D::Create(tmc.Tileset_Path);
+
+					int chunkSize = tilemapComponent["ChunkSize"].as<int>();
+					for (auto chunk : tilemapComponent["Chunks"]) {
+						int chunkX = chunk["Coord"][0].as<int>();
+						int chunkY = chunk["Coord"][1].as<int>();
+						auto runs = chunk["Runs"];
+						int index = 0;
+						for (std::size_t i = 0; i + 1 < runs.size(); i += 2) {
+							int count = runs[i].as<int>();
+							int tile = runs[i + 1].as<int>();
+							if (tile < 0) {
+								index += count;
+								continue;
+							}
+							for (int end = index + count; index < end; index++)
+								tmc.SetTile(chunkX * chunkSize + index % chunkSize, chunkY * chunkSize + index / chunkSize, tile);
+						}
+					}
+				}
+
+				auto particleEmitterComponent = object["ParticleEmitterComponent"];
+				if (particleEmitterComponent)
+				{
+					auto& pec				= deserializedObject.AddComponent<ParticleEmitterComponent>();
+					pec.MaxParticles		= particleEmitterComponent["MaxParticles"].as<uint32_t>();
+					pec.EmissionRate		= particleEmitterComponent["EmissionRate"].as<float>();
+					pec.Lifetime			= particleEmitterComponent["Lifetime"].as<float>();
+					pec.LifetimeVariation	= particleEmitterComponent["LifetimeVariation"].as<float>();
+					pec.Velocity			= particleEmitterComponent["Velocity"].as<glm::vec2>();
+					pec.VelocityVariation	= particleEmitterComponent["VelocityVariation"].as<glm::vec2>();
+					pec.Gravity				= particleEmitterComponent["Gravity"].as<glm::vec2>();
+					pec.Drag				= particleEmitterComponent["Drag"].as<float>();
+					pec.ColorBegin			= particleEmitterComponent["ColorBegin"].as<glm::vec4>();
+					pec.ColorEnd			= particleEmitterComponent["ColorEnd"].as<glm::vec4>();
+					pec.SizeBegin			= particleEmitterComponent["SizeBegin"].as<float>();
+					pec.SizeEnd				= particleEmitterComponent["SizeEnd"].as<float>();
+					pec.Layer				= particleEmitterComponent["Layer"].as<unsigned int>();
+					pec.Texture_Path		= particleEmitterComponent["Texture_Path"].as<std::string>();
+					if (!pec.Texture_Path.empty())
+						pec.Texture = Texture2D::Create(pec.Texture_Path);
+				}
+
+				auto textComponent = object["TextComponent"];
+				if (textComponent)
+				{
+					auto& tc		= deserializedObject.AddComponent<TextComponent>();
+					tc.Text			= textComponent["Text"].as<std::string>();
+					tc.Font_Path	= textComponent["Font_Path"].as<std::string>();
+					tc.Color		= textComponent["Color"].as<glm::vec4>();
+					tc.Kerning		= textComponent["Kerning"].as<float>();
+					tc.LineSpacing	= textComponent["LineSpacing"].as<float>();
+					tc.Layer		= textComponent["Layer"].as<unsigned int>();
+					tc.FontAsset	= Renderer2D::GetFont(tc.Font_Path);
+				}
+
+				auto lightComponent = object["LightComponent"];
+				if (lightComponent)
+				{
+					auto& lc		= deserializedObject.AddComponent<LightComponent>();
+					lc.LightType	= (LightComponent::Type)lightComponent["Type"].as<int>();
+					lc.Color		= lightComponent["Color"].as<glm::vec3>();
+					lc.Intensity	= lightComponent["Intensity"].as<float>();
+					lc.Radius		= lightComponent["Radius"].as<float>();
+					lc.Height		= lightComponent["Height"].as<float>();
+					lc.InnerAngle	= lightComponent["InnerAngle"].as<float>();
+					lc.OuterAngle	= lightComponent["OuterAngle"].as<float>();
 				}
 
 				auto animationComponent = object["AnimationComponent"];
@@ -429,14 +609,16 @@ namespace SurfEngine {
 					{
 						uint64_t parent = transformComponent["Parent"].as<uint64_t>();
 						int childcount = transformComponent["ChildCount"].as<int>();
-						if (parent != 0) { tc->parent = &scene->GetObjectByUUID(parent).GetComponent<TransformComponent>(); }
+						//AddChild moves a child already linked to the end, so whichever object is read first the lists end up in saved order
+						if (parent != 0) { scene->GetObjectByUUID(parent).GetComponent<TransformComponent>().AddChild(tc); }
 
 						for (int i = 0; i < childcount; i++) {
 							std::string childstr = "Child";
 							childstr += std::to_string(i);
 							uint64_t child = transformComponent[childstr].as<uint64_t>();
-							tc->children.push_back(&scene->GetObjectByUUID(child).GetComponent<TransformComponent>());
+							tc->AddChild(&scene->GetObjectByUUID(child).GetComponent<TransformComponent>());
 						}
+						tc->MarkDirty();
 					}
 				}
 			}
@@ -446,11 +628,7 @@ namespace SurfEngine {
 
 	void RecSerialize(YAML::Emitter& out, Object object) {
 		ObjectSerializer::SerializeObject(out, object);
-		TransformComponent tc = object.GetComponent<TransformComponent>();
-		std::size_t numChildren = tc.children.size();
-		for (int i = 0; i < numChildren; i++) {
-			RecSerialize(out, tc.children[i]->gameObject);
-		}
+		object.GetComponent<TransformComponent>().ForEachChild([&](TransformComponent& child) { RecSerialize(out, child.gameObject); });
 	}
 
 	void ObjectSerializer::Serialize(const std::string& filepath, Object object) {
@@ -3,10 +3,14 @@
 
 #include "Components.h"
 #include "SurfEngine/Core/KeyCodes.h"
+#include "SurfEngine/Core/JobSystem.h"
 #include "SurfEngine/Renderer/Renderer2D.h"
+#include "SurfEngine/Renderer/PostProcessing.h"
 #include "SurfEngine/Scenes/Object.h"
 
 #include <filesystem>
+#include <cfloat>
+#include <climits>
 
 #include "mono/jit/jit.h"
 #include "mono/metadata/assembly.h"
@@ -18,12 +22,31 @@
 
 namespace SurfEngine {
 
+	//The render target holds whatever scene drew last, only that scene can keep showing it
+	static const Scene* s_LastRenderedScene = nullptr;
+
+	static void RemoveSpriteRenderData(entt::registry& registry, entt::entity entity) {
+		registry.remove<SpriteRenderData>(entity);
+	}
+
+	static void ReleaseSpriteTextures(entt::registry& registry, entt::entity entity) {
+		SpriteRenderData& data = registry.get<SpriteRenderData>(entity);
+		Renderer2D::ReleaseTextureHandle(data.Texture);
+		Renderer2D::ReleaseTextureHandle(data.NormalMap);
+	}
+
 	Scene::Scene(){
 		m_Registry = entt::registry();
+		m_TransformHierarchy.Connect(m_Registry);
+		m_Registry.on_construct<SpriteRendererComponent>().connect<&Scene::OnSpriteConstruct>(*this);
+		m_Registry.on_destroy<SpriteRendererComponent>().connect<&RemoveSpriteRenderData>();
+		m_Registry.on_destroy<SpriteRenderData>().connect<&ReleaseSpriteTextures>();
+		AddSystems();
 	}
 
 	Scene::~Scene() {
-	
+		//The registry is torn down without signals, the texture handles are given back here
+		m_Registry.clear<SpriteRenderData>();
 	}
 
 	Object Scene::CreateObject(const std::string& name)
@@ -32,7 +55,8 @@ namespace SurfEngine {
 		entt::entity entity = m_Registry.create();
 		Object object = { entity, this };
 		object.AddComponent<TransformComponent>(object);
-		object.AddComponent<TagComponent>(objName);
+		m_EntityMap[object.AddComponent<TagComponent>(objName).uuid] = entity;
+		AddToNameIndex(objName, entity);
 		return object;
 	}
 
@@ -43,39 +67,102 @@ namespace SurfEngine {
 		Object object = { entity, this };
 		object.AddComponent<TransformComponent>(object);
 		object.AddComponent<TagComponent>(objName, uuid);
+		auto [it, inserted] = m_EntityMap.try_emplace(uuid, entity);
+		if (!inserted) {
+			SE_CORE_WARN("Object \"{0}\" reuses UUID {1}, lookups will find the newer object", objName, (uint64_t)uuid);
+			it->second = entity;
+		}
+		AddToNameIndex(objName, entity);
 		return object;
 	}
 
 	Object Scene::GetObjectByUUID(UUID uuid) {
-		Object o;
-		m_Registry.view<TagComponent>().each([&](auto object, TagComponent& tc) {
-			if (uuid == tc.uuid) {
-				o = Object(object, this);
-			}
-			});
-		return o;
+		auto it = m_EntityMap.find(uuid);
+		if (it == m_EntityMap.end())
+			return Object();
+
+		//Entities destroyed around DeleteObject leave entries behind, their handle fails the version check
+		entt::entity entity = it->second;
+		if (!m_Registry.valid(entity) || !m_Registry.all_of<TagComponent>(entity) || m_Registry.get<TagComponent>(entity).uuid != uuid) {
+			SE_CORE_WARN("Stale handle for UUID {0} dropped", (uint64_t)uuid);
+			m_EntityMap.erase(it);
+			return Object();
+		}
+		return Object(entity, this);
 	}
 
-	Object Scene::GetObjectByName(std::string name) {
-		Object o;
-		m_Registry.view<TagComponent>().each([&](auto object, TagComponent& tc) {
-			if (name._Equal(tc.Tag)) {
-				o = Object(object, this);
-			}
-			});
-		return o;
+	void Scene::AddToNameIndex(const std::string& name, entt::entity entity) {
+		auto it = m_NameIndex.find(name);
+		if (it == m_NameIndex.end()) {
+			it = m_NameIndex.emplace(name, std::vector<entt::entity>()).first;
+			//Keys of the ordered index do not move, so the view stays valid until the name is removed
+			m_NameLookup[std::string_view(it->first)] = &it->second;
+		}
+		it->second.push_back(entity);
+	}
+
+	void Scene::RemoveFromNameIndex(const std::string& name, entt::entity entity) {
+		auto it = m_NameIndex.find(name);
+		if (it == m_NameIndex.end())
+			return;
+		std::vector<entt::entity>& entities = it->second;
+		entities.erase(std::remove(entities.begin(), entities.end(), entity), entities.end());
+		if (entities.empty()) {
+			m_NameLookup.erase(std::string_view(it->first));
+			m_NameIndex.erase(it);
+		}
+	}
+
+	void Scene::RenameObject(Object object, const std::string& name) {
+		TagComponent& tc = object.GetComponent<TagComponent>();
+		if (tc.Tag == name)
+			return;
+		RemoveFromNameIndex(tc.Tag, object);
+		tc.Tag = name;
+		AddToNameIndex(tc.Tag, object);
+		MarkDirty();
+	}
+
+	Object Scene::GetObjectByName(std::string_view name) {
+		auto it = m_NameLookup.find(name);
+		if (it == m_NameLookup.end())
+			return Object();
+		return Object(it->second->front(), this);
+	}
+
+	std::vector<Object> Scene::GetObjectsByName(std::string_view name) {
+		std::vector<Object> objects;
+		auto it = m_NameLookup.find(name);
+		if (it != m_NameLookup.end()) {
+			for (entt::entity entity : *it->second)
+				objects.push_back(Object(entity, this));
+		}
+		return objects;
+	}
+
+	std::vector<Object> Scene::GetObjectsByNamePrefix(std::string_view prefix) {
+		std::vector<Object> objects;
+		for (auto it = m_NameIndex.lower_bound(prefix); it != m_NameIndex.end() && it->first.compare(0, prefix.size(), prefix) == 0; it++) {
+			for (entt::entity entity : it->second)
+				objects.push_back(Object(entity, this));
+		}
+		return objects;
 	}
 
 	Object Scene::DuplicateObject(Object source_obj)
 	{
 		Object duplicate = CreateObject(source_obj.GetComponent<TagComponent>().Tag + "_dup", SurfEngine::UUID());
 		TransformComponent& oldtc = source_obj.GetComponent<TransformComponent>();
-		duplicate.GetComponent<TransformComponent>().Scale = oldtc.Scale;
-		duplicate.GetComponent<TransformComponent>().Rotation = oldtc.Rotation;
-		duplicate.GetComponent<TransformComponent>().Translation = oldtc.Translation;
+		duplicate.GetComponent<TransformComponent>().SetScale(oldtc.Scale);
+		duplicate.GetComponent<TransformComponent>().SetRotation(oldtc.Rotation);
+		duplicate.GetComponent<TransformComponent>().SetTranslation(oldtc.Translation);
 		if (source_obj.HasComponent<CameraComponent>()) { duplicate.AddComponent<CameraComponent>(source_obj.GetComponent<CameraComponent>());}
 		if (source_obj.HasComponent<AnimationComponent>()) { duplicate.AddComponent<AnimationComponent>(source_obj.GetComponent<AnimationComponent>()); }
 		if (source_obj.HasComponent<SpriteRendererComponent>()) { duplicate.AddComponent<SpriteRendererComponent>(source_obj.GetComponent<SpriteRendererComponent>()); }
+		if (source_obj.HasComponent<TilemapComponent>()) { duplicate.AddComponent<TilemapComponent>(source_obj.GetComponent<TilemapComponent>()); }
+		if (source_obj.HasComponent<TextComponent>()) { duplicate.AddComponent<TextComponent>(source_obj.GetComponent<TextComponent>()); }
+		if (source_obj.HasComponent<LightComponent>()) { duplicate.AddComponent<LightComponent>(source_obj.GetComponent<LightComponent>()); }
+		if (source_obj.HasComponent<ParticleEmitterComponent>()) { duplicate.AddComponent<ParticleEmitterComponent>(source_obj.GetComponent<ParticleEmitterComponent>()).Pool = nullptr; }
 		if (source_obj.HasComponent<ScriptComponent>()) { duplicate.AddComponent<ScriptComponent>(source_obj.GetComponent<ScriptComponent>()); }
 		if (source_obj.HasComponent<BoxColliderComponent>()) { duplicate.AddComponent<BoxColliderComponent>(source_obj.GetComponent<BoxColliderComponent>()); }
 		if (source_obj.HasComponent<CircleColliderComponent>()) { duplicate.AddComponent<CircleColliderComponent>(source_obj.GetComponent<CircleColliderComponent>()); }
@@ -86,15 +173,18 @@ namespace SurfEngine {
 
 	void Scene::DeleteObject(Object obj)
 	{
-		TransformComponent& tc = obj.GetComponent<TransformComponent>();
+		obj.GetComponent<TransformComponent>().ForEachChild([this](TransformComponent& child) { DeleteObject(child.gameObject); });
 
-		for (TransformComponent* c : tc.children) {
-			DeleteObject(c->gameObject);
-		}
-
-		if (tc.parent)
-			tc.parent->RemoveChild(&tc);
+		//Destroying the children can move this transform in storage
+		TransformComponent& tc = obj.GetComponent<TransformComponent>();
+		if (TransformComponent* parent = tc.GetParent())
+			parent->RemoveChild(&tc);
+		RemoveFromNameIndex(obj.GetComponent<TagComponent>().Tag, obj);
+		auto it = m_EntityMap.find(obj.GetComponent<TagComponent>().uuid);
+		if (it != m_EntityMap.end() && it->second == (entt::entity)obj)
+			m_EntityMap.erase(it);
 		m_Registry.destroy(obj);
+		MarkDirty();
 	}
 
 	std::size_t Scene::ObjectCount() {
@@ -106,7 +196,12 @@ namespace SurfEngine {
 
 		m_Registry.view<AnimationComponent>().each([=](auto object, AnimationComponent& ac) {
 			ac.play = ac.playOnAwake;
+			ac.startTime = 0.0f;
 			});
+		m_Time = 0.0f;
+		m_FixedAccumulator = 0.0f;
+		m_FixedAlpha = 0.0f;
+		m_FixedSteps = 0;
 
 		//TODO: Added Main Camera Code
 		m_Registry.view<CameraComponent>().each([=](auto object, CameraComponent& cc) {
@@ -155,6 +250,8 @@ namespace SurfEngine {
 					}
 				}
 				
+				//OnFixedUpdate is optional and called up to max_substeps times a frame, so it is looked up here once
+				cc.fixed_update_method = cc.monoclass.GetMethod("OnFixedUpdate", 0);
 				cc.monoclass.InvokeMethod(cc.script_class_instance, cc.monoclass.GetMethod("OnStart", 0));
 			}
 			else {
@@ -166,94 +263,358 @@ namespace SurfEngine {
 		m_IsPlaying = true;
 	}
 
-	void Scene::OnUpdateRuntime(Timestep ts) {	
-	
-		//TODO: Added Main Camera Code
-		m_Registry.view<CameraComponent>().each([=](auto object, CameraComponent& cc) {
-			m_sceneCamera = std::make_shared<SceneCamera>(cc.Camera);
+	void Scene::AddSystems() {
+		//Creating pools and groups is not thread safe, the ones the systems use exist before the first run
+		(void)m_Registry.view<RigidbodyComponent, ScriptComponent, ParticleEmitterComponent, TransformComponent>();
+		(void)m_Registry.group<CameraComponent>(entt::get<TransformComponent>);
+
+		//Fixed step systems get the fixed step as their timestep
+		m_FixedSystems.Add("Physics", SystemScheduler::Access().Write<RigidbodyComponent>(),
+			[this](Timestep ts) { PhysicsEngine::OnPhysics2DUpdate(ts, this); });
+
+		m_FixedSystems.Add("Fixed Scripts", SystemScheduler::Access().WriteAll().MainThread(), [this](Timestep) {
+			m_Registry.view<ScriptComponent>().each([=](auto object, ScriptComponent& cc) {
+				if (!cc.fixed_update_method)
+					return;
+				ScriptEngine::SetCurrentScene(this);
+				cc.monoclass.InvokeMethod(cc.script_class_instance, cc.fixed_update_method);
 			});
+		});
 
-		PhysicsEngine::OnPhysics2DUpdate(ts,this);
-		
-
-		m_Registry.view<ScriptComponent>().each([=](auto object, ScriptComponent& cc) {
-			ScriptEngine::SetCurrentScene(this);
-			cc.monoclass.InvokeMethod(cc.script_class_instance, cc.monoclass.GetMethod("OnUpdate", 0));
+		m_Systems.Add("Physics Interpolation", SystemScheduler::Access().Read<RigidbodyComponent>().Write<TransformComponent>(), [this](Timestep) {
+			PhysicsEngine::InterpolateTransforms(this, m_FixedAlpha);
 		});
 
-		if (m_sceneCamera) {
-			Renderer2D::BeginScene(m_sceneCamera.get());
-			
+		m_Systems.Add("Scripts", SystemScheduler::Access().WriteAll().MainThread(), [this](Timestep) {
+			m_Registry.view<ScriptComponent>().each([=](auto object, ScriptComponent& cc) {
+				ScriptEngine::SetCurrentScene(this);
+				cc.monoclass.InvokeMethod(cc.script_class_instance, cc.monoclass.GetMethod("OnUpdate", 0));
+			});
+		});
 
-			auto animgroup = m_Registry.group<AnimationComponent>(entt::get<SpriteRendererComponent>);
-			for (auto entity : animgroup) {
-				auto [anim, sprite] = animgroup.get<AnimationComponent, SpriteRendererComponent>(entity);
-				
-				anim.Tick(ts);
+		//World transforms are brought up to date once here, the systems after it only read the cached ones
+		m_Systems.Add("Transforms", SystemScheduler::Access().Write<TransformComponent>(),
+			[this](Timestep) { m_TransformHierarchy.Update(m_Registry); });
+
+		m_Systems.Add("Particles", SystemScheduler::Access().Read<TransformComponent>().Write<ParticleEmitterComponent>(), [this](Timestep ts) {
+			//Pools and origins are set up first so the emitters can run on the workers
+			std::vector<std::pair<ParticleEmitterComponent*, glm::vec2>> emitters;
+			m_Registry.view<ParticleEmitterComponent, TransformComponent>().each([&](auto object, ParticleEmitterComponent& pec, TransformComponent& tc) {
+				if (!pec.Pool || pec.Pool->GetCapacity() != pec.MaxParticles)
+					pec.Pool = std::make_shared<ParticlePool>(pec.MaxParticles);
+				emitters.emplace_back(&pec, glm::vec2(tc.GetCachedTransform()[3]));
+			});
+			JobSystem::ParallelFor((uint32_t)emitters.size(), 1, [&](uint32_t begin, uint32_t end) {
+				for (uint32_t i = begin; i < end; i++)
+					emitters[i].first->Pool->Update(*emitters[i].first, emitters[i].second, ts);
+			});
+		});
 
-				sprite.currFrame = anim.currframe;
-				sprite.totalFrames = anim.frames;
+		//TODO: Added Main Camera Code
+		//On the main thread as it hands the scene camera to the renderer
+		m_Systems.Add("Cameras", SystemScheduler::Access().Read<TransformComponent>().Write<CameraComponent>().MainThread(), [this](Timestep) {
+			auto groupCamera = m_Registry.group<CameraComponent>(entt::get<TransformComponent>);
+			for (auto entity : groupCamera) {
+				auto [camera, transform] = groupCamera.get<CameraComponent, TransformComponent>(entity);
+				camera.Camera.m_Transform = transform.GetCachedTransform();
+				camera.Camera.UpdateView();
+				m_sceneCamera = std::make_shared<SceneCamera>(camera.Camera);
 			}
+		});
+	}
 
-			//Draw Sprites
-			auto group = m_Registry.group<SpriteRendererComponent>(entt::get<TransformComponent>);
-			group.sort<SpriteRendererComponent>([](const SpriteRendererComponent& lhs, const SpriteRendererComponent& rhs) {
-				return lhs.Layer < rhs.Layer;
-				});
+	void Scene::OnUpdateRuntime(Timestep ts) {
+		m_Time += ts;
+
+		//Simulation advances in fixed steps, the frame draws the bodies part way into the next one
+		const float step = std::max(PhysicsEngine::s_Data.fixed_timestep, 0.001f);
+		m_FixedAccumulator += ts;
+		m_FixedSteps = 0;
+		while (m_FixedAccumulator >= step && m_FixedSteps < PhysicsEngine::s_Data.max_substeps) {
+			m_FixedSystems.Run(step);
+			m_FixedAccumulator -= step;
+			m_FixedSteps++;
+		}
+		//Catching up after a hitch would make the next frame longer still, the simulation falls behind instead
+		if (m_FixedAccumulator >= step)
+			m_FixedAccumulator = std::fmod(m_FixedAccumulator, step);
+		m_FixedAlpha = m_FixedAccumulator / step;
 
-			for (auto entity : group) {
-				auto [sprite, transform] = group.get<SpriteRendererComponent, TransformComponent>(entity);
-				if (sprite.Texture) { 
-					Renderer2D::DrawQuad(transform.GetTransform(), std::make_shared<SpriteRendererComponent>(sprite), sprite.currFrame, sprite.totalFrames);
-				}
-				else {
-					Renderer2D::DrawQuad(transform.GetTransform(), sprite.Color);
-				}
-			}
+		m_Systems.Run(ts);
 
-			Renderer2D::EndScene();
+		if (m_sceneCamera) {
+			RenderScene(m_sceneCamera.get(), nullptr);
 		}
 		else {
 			Renderer2D::ClearRenderTarget();
 			SE_CORE_WARN("No Scene Camera Detected!");
 		}
+	}
 
-		//Update Camera
-		auto groupCamera = m_Registry.group<CameraComponent>(entt::get<TransformComponent>);
-		for (auto entity : groupCamera) {
-			auto [camera, transform] = groupCamera.get<CameraComponent, TransformComponent>(entity);
-			camera.Camera.m_Transform = transform.GetTransform();
-			camera.Camera.UpdateView();
+	void Scene::SetLayerStatic(unsigned int layer, bool isStatic) {
+		MarkDirty();
+		if (isStatic) {
+			m_StaticLayers.insert(layer);
+		}
+		else {
+			m_StaticLayers.erase(layer);
 		}
 	}
 
-	void Scene::OnUpdateEditor(Timestep ts, Ref<SceneCamera> camera, bool draw_grid, Ref<Object> selected) {
-		SetSceneCamera(camera);
-		Renderer2D::BeginScene(camera.get());
-		if (draw_grid) { Renderer2D::DrawBackgroundGrid(1); }
-		
-		auto animgroup = m_Registry.group<AnimationComponent>(entt::get<SpriteRendererComponent>);
-		for (auto entity : animgroup) {
-			auto [anim, sprite] = animgroup.get<AnimationComponent, SpriteRendererComponent>(entity);
-			sprite.currFrame = anim.currframe;
-			sprite.totalFrames = anim.frames;
+	bool Scene::IsLayerStatic(unsigned int layer) const {
+		return m_StaticLayers.count(layer) != 0;
+	}
+
+	//FNV-1a over the raw bytes
+	static void HashBytes(size_t& hash, const void* data, size_t size) {
+		const unsigned char* bytes = (const unsigned char*)data;
+		for (size_t i = 0; i < size; i++) {
+			hash ^= bytes[i];
+			hash *= (size_t)1099511628211ULL;
+		}
+	}
+
+	//Fields are filled in after the component is added, so the render data is built on the next draw
+	void Scene::OnSpriteConstruct(entt::registry& registry, entt::entity entity) {
+		registry.emplace<SpriteRenderData>(entity);
+		m_SpritesDirty = true;
+	}
+
+	void Scene::UpdateSpriteRenderData(entt::entity entity) {
+		MarkDirty();
+		const SpriteRendererComponent& sprite = m_Registry.get<SpriteRendererComponent>(entity);
+		SpriteRenderData& data = m_Registry.get<SpriteRenderData>(entity);
+
+		//New handles are taken before the old ones are given back, so an unchanged texture never leaves the table
+		uint32_t texture = Renderer2D::AcquireTextureHandle(sprite.Texture);
+		uint32_t normalMap = Renderer2D::AcquireTextureHandle(sprite.NormalMap);
+		Renderer2D::ReleaseTextureHandle(data.Texture);
+		Renderer2D::ReleaseTextureHandle(data.NormalMap);
+
+		data.Color = sprite.Color;
+		data.Scaling = sprite.scaling;
+		data.Offset = sprite.offset;
+		data.Layer = sprite.Layer;
+		data.Texture = texture;
+		data.NormalMap = normalMap;
+		data.MeshVertexBudget = sprite.MeshVertexBudget;
+		data.Flags = 0;
+		if (sprite.flipX)
+			data.Flags |= SpriteRenderData::FlipX;
+		if (Renderer2D::IsSpriteOpaque(sprite))
+			data.Flags |= SpriteRenderData::Opaque;
+		if (sprite.Texture && sprite.Texture->GetAlphaMode() == Texture2D::AlphaMode::Cutout)
+			data.Flags |= SpriteRenderData::Cutout;
+	}
+
+	void Scene::DrawSprites() {
+		//Only the compact render data is walked below, the authoring components are read when sprites were added
+		if (m_SpritesDirty) {
+			for (auto entity : m_Registry.view<SpriteRendererComponent>())
+				UpdateSpriteRenderData(entity);
+			m_SpritesDirty = false;
 		}
 
-		auto group = m_Registry.group<SpriteRendererComponent>(entt::get<TransformComponent>);
-		group.sort<SpriteRendererComponent>([](const SpriteRendererComponent& lhs, const SpriteRendererComponent& rhs) {
+		auto group = m_Registry.group<SpriteRenderData>(entt::get<TransformComponent>);
+		group.sort<SpriteRenderData>([](const SpriteRenderData& lhs, const SpriteRenderData& rhs) {
 			return lhs.Layer < rhs.Layer;
 			});
-		for (auto entity : group) {
-			auto [sprite, transform] = group.get<SpriteRendererComponent, TransformComponent>(entity);
 
-			if (sprite.Texture) {	
-				Renderer2D::DrawQuad(transform.GetTransform(), std::make_shared<SpriteRendererComponent>(sprite), sprite.currFrame, sprite.totalFrames);
+		//Tilemaps and particles are drawn before the sprites that share their layer
+		std::vector<std::pair<unsigned int, std::function<void()>>> layered;
+		m_Registry.view<TilemapComponent, TransformComponent>().each([&](auto object, TilemapComponent& tilemap, TransformComponent& transform) {
+			layered.emplace_back(tilemap.Layer, [&]() { Renderer2D::DrawTilemap(transform.GetTransform(), tilemap); });
+			});
+		m_Registry.view<ParticleEmitterComponent>().each([&](auto object, ParticleEmitterComponent& emitter) {
+			layered.emplace_back(emitter.Layer, [&]() { Renderer2D::DrawParticles(emitter); });
+			});
+		std::stable_sort(layered.begin(), layered.end(), [](const auto& lhs, const auto& rhs) {
+			return lhs.first < rhs.first;
+			});
+		size_t nextLayered = 0;
+		auto drawLayered = [&](unsigned int maxLayer) {
+			for (; nextLayered < layered.size() && layered[nextLayered].first <= maxLayer; nextLayered++)
+				layered[nextLayered].second();
+		};
+
+		//Sprites of a layer spread over its depth slice in draw order, so depth testing gives the same result as drawing in order
+		std::vector<entt::entity> order(group.begin(), group.end());
+		std::vector<float> depthOrder(order.size());
+		std::vector<bool> opaque(order.size());
+		for (size_t begin = 0; begin < order.size();) {
+			const unsigned int layer = group.get<SpriteRenderData>(order[begin]).Layer;
+			size_t end = begin;
+			while (end < order.size() && group.get<SpriteRenderData>(order[end]).Layer == layer)
+				end++;
+
+			for (size_t i = begin; i < end; i++) {
+				depthOrder[i] = (float)(i - begin + 1) / (float)(end - begin);
+				opaque[i] = !IsLayerStatic(layer) && (group.get<SpriteRenderData>(order[i]).Flags & SpriteRenderData::Opaque);
 			}
-			else {
-				Renderer2D::DrawQuad(transform.GetTransform(), sprite.Color);
+			begin = end;
+		}
+
+		//Opaque sprites front to back, whatever they cover fails the depth test instead of being shaded and blended
+		Renderer2D::SetSpritePass(Renderer2D::SpritePass::Opaque);
+		for (size_t i = order.size(); i-- > 0;) {
+			if (!opaque[i])
+				continue;
+			auto [sprite, transform] = group.get<SpriteRenderData, TransformComponent>(order[i]);
+			Renderer2D::DrawSprite(transform.GetTransform(), sprite, m_Registry.try_get<AnimationComponent>(order[i]), depthOrder[i]);
+		}
+
+		//Everything else back to front, tested against the opaque sprites but not writing depth
+		Renderer2D::SetSpritePass(Renderer2D::SpritePass::Translucent);
+		std::vector<std::pair<const SpriteRenderData*, glm::mat4>> staticSprites;
+		for (size_t i = 0; i < order.size();) {
+			const unsigned int layer = group.get<SpriteRenderData>(order[i]).Layer;
+			drawLayered(layer);
+
+			if (!IsLayerStatic(layer)) {
+				if (!opaque[i]) {
+					auto [sprite, transform] = group.get<SpriteRenderData, TransformComponent>(order[i]);
+					Renderer2D::DrawSprite(transform.GetTransform(), sprite, m_Registry.try_get<AnimationComponent>(order[i]), depthOrder[i]);
+				}
+				++i;
+				continue;
+			}
+
+			//Gather the layer, animated sprites change every frame so they are drawn on top of the cache
+			staticSprites.clear();
+			size_t hash = (size_t)14695981039346656037ULL;
+			glm::vec4 bounds(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+			for (; i < order.size() && group.get<SpriteRenderData>(order[i]).Layer == layer; ++i) {
+				auto [sprite, transform] = group.get<SpriteRenderData, TransformComponent>(order[i]);
+				if (auto* animation = m_Registry.try_get<AnimationComponent>(order[i])) {
+					Renderer2D::DrawSprite(transform.GetTransform(), sprite, animation, depthOrder[i]);
+					continue;
+				}
+
+				glm::mat4 world = transform.GetTransform();
+				staticSprites.emplace_back(&sprite, world);
+
+				//Handles are reused once released, the texture itself identifies the contents
+				const Texture2D* texture = Renderer2D::GetTexture(sprite.Texture).get();
+				HashBytes(hash, &world, sizeof(world));
+				HashBytes(hash, &sprite.Color, sizeof(sprite.Color));
+				HashBytes(hash, &texture, sizeof(texture));
+				HashBytes(hash, &sprite.Flags, sizeof(sprite.Flags));
+				HashBytes(hash, &sprite.Scaling, sizeof(sprite.Scaling));
+				HashBytes(hash, &sprite.Offset, sizeof(sprite.Offset));
+
+				for (glm::vec2 corner : { glm::vec2(-0.5f, -0.5f), glm::vec2(0.5f, -0.5f), glm::vec2(0.5f, 0.5f), glm::vec2(-0.5f, 0.5f) }) {
+					glm::vec4 p = world * glm::vec4(corner, 0.0f, 1.0f);
+					bounds = glm::vec4(glm::min(glm::vec2(bounds), glm::vec2(p)), glm::max(glm::vec2(bounds.z, bounds.w), glm::vec2(p)));
+				}
 			}
+
+			if (staticSprites.empty())
+				continue;
+
+			Renderer2D::DrawStaticLayer(layer, hash, bounds, [&]() {
+				for (auto& [sprite, world] : staticSprites)
+					Renderer2D::DrawSprite(world, *sprite);
+			});
 		}
+		drawLayered(UINT_MAX);
+		Renderer2D::SetSpritePass(Renderer2D::SpritePass::Painter);
+
+		//Text goes over the sprites in layer order, every string of a font ends up in the same draw
+		std::vector<std::pair<const TextComponent*, const TransformComponent*>> texts;
+		m_Registry.view<TextComponent, TransformComponent>().each([&](auto object, TextComponent& text, TransformComponent& transform) {
+			texts.emplace_back(&text, &transform);
+			});
+		std::stable_sort(texts.begin(), texts.end(), [](const auto& lhs, const auto& rhs) {
+			return lhs.first->Layer < rhs.first->Layer;
+			});
+		for (auto& [text, transform] : texts)
+			Renderer2D::DrawString(transform->GetTransform(), *text);
+		Renderer2D::FlushText();
+	}
+
+	void Scene::SubmitLights() {
+		auto view = m_Registry.view<LightComponent, TransformComponent>();
+		if (view.begin() == view.end())
+			return;
+
+		Renderer2D::BeginLighting(glm::vec3(0.0f));
+		view.each([](auto object, LightComponent& light, TransformComponent& transform) {
+			Renderer2D::SubmitLight(transform.GetTransform(), light);
+			});
+		Renderer2D::EndLighting();
+	}
 
+	void Scene::RenderScene(const Camera* camera, const EditorOverlay* overlay) {
+		s_LastRenderedScene = this;
+		Renderer2D::BeginScene(camera);
+		Renderer2D::SetTime(m_IsPlaying ? m_Time : 0.0f);
+
+		//Editor overlays land in the same target but are only an output in the editor, at runtime their passes are culled
+		m_RenderGraph.Reset();
+		RenderGraph::Resource sceneColor = m_RenderGraph.Import("Scene Color", Renderer2D::GetRenderTarget());
+		RenderGraph::Resource editorOverlay = m_RenderGraph.Import("Editor Overlay", Renderer2D::GetRenderTarget());
+		m_RenderGraph.MarkOutput(sceneColor);
+		if (overlay)
+			m_RenderGraph.MarkOutput(editorOverlay);
+
+		bool drawGrid = overlay && overlay->DrawGrid;
+		Ref<Object> selected = overlay ? overlay->Selected : nullptr;
+		m_RenderGraph.AddPass("Background Grid",
+			[&](RenderGraph::PassBuilder& builder) { builder.Write(editorOverlay); },
+			[drawGrid](RenderGraph&) { if (drawGrid) { Renderer2D::DrawBackgroundGrid(1); } });
+		RenderGraph::Resource lightTiles = m_RenderGraph.Import("Light Tiles", nullptr);
+		m_RenderGraph.AddPass("Light Culling",
+			[&](RenderGraph::PassBuilder& builder) { builder.Write(lightTiles); },
+			[this](RenderGraph&) { SubmitLights(); });
+		m_RenderGraph.AddPass("Sprites",
+			[&](RenderGraph::PassBuilder& builder) { builder.Read(lightTiles); builder.Write(sceneColor); },
+			[this](RenderGraph&) { DrawSprites(); });
+		//Gizmos go on top of the post processed image, so they are not bloomed or graded
+		RenderGraph::Resource finalColor = PostProcessing::AddPasses(m_RenderGraph, sceneColor, Renderer2D::GetOutputSize());
+		m_RenderGraph.MarkOutput(finalColor);
+		Ref<Framebuffer> finalTarget = m_RenderGraph.GetFramebuffer(finalColor);
+		RenderGraph::Resource gizmoOverlay = m_RenderGraph.Import("Gizmo Overlay", finalTarget);
+		if (overlay)
+			m_RenderGraph.MarkOutput(gizmoOverlay);
+		m_RenderGraph.AddPass("Gizmos",
+			[&](RenderGraph::PassBuilder& builder) { builder.Read(finalColor); builder.Write(gizmoOverlay); },
+			[this, selected, finalTarget](RenderGraph&) { finalTarget->Bind(); DrawEditorGizmos(selected); });
+
+		m_RenderGraph.Execute();
+		Renderer2D::SetOutput(finalTarget);
+		Renderer2D::EndScene();
+	}
+
+	void Scene::OnUpdateEditor(Timestep ts, Ref<SceneCamera> camera, bool draw_grid, Ref<Object> selected) {
+		SetSceneCamera(camera);
+
+		EditorFrameState state;
+		state.Projection = camera->GetProjection();
+		state.View = camera->GetView();
+		state.OutputSize = Renderer2D::GetOutputSize();
+		state.RenderSize = Renderer2D::GetRenderTargetSize();
+		state.DrawGrid = draw_grid;
+		state.Selected = selected ? (entt::entity)*selected : entt::null;
+		//Nothing visible changed, the viewport keeps showing the last frame
+		if (!m_Dirty && s_LastRenderedScene == this && state == m_LastEditorFrame)
+			return;
+		m_Dirty = false;
+		m_LastEditorFrame = state;
+
+		//Everything drawn reads world transforms, one pass brings them all up to date, at runtime the Transforms system does
+		m_TransformHierarchy.Update(m_Registry);
+		EditorOverlay overlay;
+		overlay.DrawGrid = draw_grid;
+		overlay.Selected = selected;
+		RenderScene(camera.get(), &overlay);
+	}
+
+	void Scene::Render(const Camera& camera) {
+		m_TransformHierarchy.Update(m_Registry);
+		RenderScene(&camera, nullptr);
+	}
+
+	void Scene::DrawEditorGizmos(Ref<Object> selected) {
 		auto groupCamera = m_Registry.group<CameraComponent>(entt::get<TransformComponent>);
 		for (auto entity : groupCamera) {
 			auto [camera, transform] = groupCamera.get<CameraComponent, TransformComponent>(entity);
@@ -313,11 +674,11 @@ namespace SurfEngine {
 			transform = glm::scale(transform, { bc.Radius*2.f, bc.Radius*2.f, 1.0f });
 			Renderer2D::DrawCircle(transform, color);
 		}
-		Renderer2D::EndScene();
 	}
 
 	void Scene::OnSceneEnd() {
 		m_IsPlaying = false;
+		MarkDirty();
 		m_sceneCamera = nullptr;
 
 		ScriptEngine::SceneEnd();
@@ -1,15 +1,27 @@
 #pragma once
 #include "entt.hpp"
+#include <set>
+#include <map>
+#include <string_view>
 
 #include "SurfEngine/Core/UUID.h"
 #include "SurfEngine/Core/Timestep.h"
 #include "SurfEngine/Scenes/SceneCamera.h"
 #include "SurfEngine/Renderer/Camera.h"
+#include "SurfEngine/Renderer/RenderGraph.h"
+#include "SurfEngine/Scenes/TransformHierarchy.h"
+#include "SurfEngine/Scenes/SystemScheduler.h"
 
 namespace SurfEngine {
 	class Object;
 
 	class Scene {
+	public:
+		// Editor only drawing, without it the render graph culls the editor passes
+		struct EditorOverlay {
+			bool DrawGrid = true;
+			Ref<Object> Selected;
+		};
 	public:
 		Scene();
 		~Scene();
@@ -21,8 +33,15 @@ namespace SurfEngine {
 		Object CreateObject(const std::string& name = "");
 		Object CreateObject(const std::string& name, UUID uuid);
 
+		// Hashed lookup kept by CreateObject and DeleteObject, returns a null Object for unknown or destroyed ids
 		Object GetObjectByUUID(UUID uuid);
-		Object GetObjectByName(std::string name);
+		// Names are indexed, keep them in sync by renaming through the scene
+		void RenameObject(Object object, const std::string& name);
+		// First object created with the name, or a null Object
+		Object GetObjectByName(std::string_view name);
+		std::vector<Object> GetObjectsByName(std::string_view name);
+		// Every object whose name starts with prefix, ordered by name
+		std::vector<Object> GetObjectsByNamePrefix(std::string_view prefix);
 		
 		Object DuplicateObject(Object source_obj);
 		void DeleteObject(Object obj);
@@ -33,12 +52,17 @@ namespace SurfEngine {
 		void OnUpdateRuntime(Timestep ts);
 		void OnUpdateEditor(Timestep ts, Ref<SceneCamera> camera, bool draw_grid, Ref<Object> selected);
 		void OnSceneEnd();
+		// Draws the scene through camera into the Renderer2D target without running systems or editor overlays
+		void Render(const Camera& camera);
 
 
 		entt::registry* GetRegistry() { return &m_Registry; }
 
 		bool IsPlaying() { return m_IsPlaying; }
 
+		// Seconds of runtime since OnSceneStart, animations are timed against it
+		float GetTime() const { return m_Time; }
+
 		Ref<SceneCamera> GetSceneCamera() {
 			return m_sceneCamera;
 		}
@@ -47,14 +71,80 @@ namespace SurfEngine {
 			m_sceneCamera = camera;
 		}
 
+		// Sprites on a static layer are cached by Renderer2D and redrawn only when they change
+		void SetLayerStatic(unsigned int layer, bool isStatic);
+		bool IsLayerStatic(unsigned int layer) const;
+		const std::set<unsigned int>& GetStaticLayers() const { return m_StaticLayers; }
+
+		// Graph of the last rendered frame, for its statistics
+		const RenderGraph& GetRenderGraph() const { return m_RenderGraph; }
+		const TransformHierarchy& GetTransformHierarchy() const { return m_TransformHierarchy; }
+		// Runtime update systems, with the timings of the last frame
+		const SystemScheduler& GetSystemScheduler() const { return m_Systems; }
+		// Systems run once per fixed step, with the timings of the last step
+		const SystemScheduler& GetFixedSystemScheduler() const { return m_FixedSystems; }
+		// Fixed steps run by the last frame
+		uint32_t GetFixedSteps() const { return m_FixedSteps; }
+
+		// The editor only redraws the viewport when something changed, edits that go around the scene call this
+		void MarkDirty() { m_Dirty = true; }
+		bool IsDirty() const { return m_Dirty; }
+
+		// Brings one sprite's SpriteRenderData in line with its SpriteRendererComponent after it was edited
+		void UpdateSpriteRenderData(entt::entity entity);
+
+	private:
+		void AddSystems();
+		void RenderScene(const Camera* camera, const EditorOverlay* overlay);
+		// Bins the scene's lights for the sprites, scenes without lights stay unlit
+		void SubmitLights();
+		void DrawSprites();
+		void OnSpriteConstruct(entt::registry& registry, entt::entity entity);
+		void DrawEditorGizmos(Ref<Object> selected);
+		void AddToNameIndex(const std::string& name, entt::entity entity);
+		void RemoveFromNameIndex(const std::string& name, entt::entity entity);
+	private:
+		// What the last editor frame was drawn with, a frame drawn with the same state would look the same
+		struct EditorFrameState {
+			glm::mat4 Projection = glm::mat4(0.0f);
+			glm::mat4 View = glm::mat4(0.0f);
+			glm::uvec2 OutputSize = glm::uvec2(0);
+			glm::vec2 RenderSize = glm::vec2(0.0f);
+			bool DrawGrid = false;
+			entt::entity Selected = entt::null;
+
+			bool operator==(const EditorFrameState& other) const {
+				return Projection == other.Projection && View == other.View && OutputSize == other.OutputSize
+					&& RenderSize == other.RenderSize && DrawGrid == other.DrawGrid && Selected == other.Selected;
+			}
+		};
 	private:
 		bool m_IsPlaying = false;
+		float m_Time = 0.0f;
 		entt::registry m_Registry;
+		std::unordered_map<UUID, entt::entity> m_EntityMap;
+		// Each distinct name is stored once, ordered for prefix queries, and hashed by view for exact lookups
+		std::map<std::string, std::vector<entt::entity>, std::less<>> m_NameIndex;
+		std::unordered_map<std::string_view, std::vector<entt::entity>*> m_NameLookup;
 		std::string m_name;
 		Ref<SceneCamera> m_sceneCamera;
+		std::set<unsigned int> m_StaticLayers;
+		RenderGraph m_RenderGraph;
+		TransformHierarchy m_TransformHierarchy;
+		SystemScheduler m_Systems;
+		SystemScheduler m_FixedSystems;
+		// Time not yet simulated, always less than one fixed step after a frame
+		float m_FixedAccumulator = 0.0f;
+		// How far into the next fixed step the frame is drawn, from 0 to 1
+		float m_FixedAlpha = 0.0f;
+		uint32_t m_FixedSteps = 0;
+		bool m_Dirty = true;
+		bool m_SpritesDirty = true;
+		EditorFrameState m_LastEditorFrame;
 		friend class Object;
 		friend class Panel_Hierarchy;
 		friend class Panel_Inspector;
 		friend class SceneSerializer;
+		friend class SceneSnapshot;
 	};
 }
\ No newline at end of file
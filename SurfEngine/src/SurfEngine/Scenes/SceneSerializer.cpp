@@ -20,6 +20,10 @@ namespace SurfEngine {
 		YAML::Emitter out;
 		out << YAML::BeginMap;
 		out << YAML::Key << "Scene" << YAML::Value << m_Scene->GetName();
+		out << YAML::Key << "StaticLayers" << YAML::Value << YAML::Flow << YAML::BeginSeq;
+		for (unsigned int layer : m_Scene->GetStaticLayers())
+			out << layer;
+		out << YAML::EndSeq;
 		out << YAML::Key << "Objects" << YAML::Value << YAML::BeginSeq;
 		m_Scene->m_Registry.each([&](auto objectId)
 			{
@@ -54,6 +58,12 @@ namespace SurfEngine {
 		std::string sceneName = data["Scene"].as<std::string>();
 		m_Scene->SetName(sceneName);
 		SE_CORE_TRACE("Deserializing scene '{0}'", sceneName);
+
+		if (auto staticLayers = data["StaticLayers"]) {
+			for (auto layer : staticLayers)
+				m_Scene->SetLayerStatic(layer.as<unsigned int>(), true);
+		}
+
 		ObjectSerializer::DeserialzeObject(data, m_Scene);
 		return true;
 	}
@@ -0,0 +1,115 @@
+#include "sepch.h"
+#include "SceneSnapshot.h"
+
+#include "Components.h"
+
+namespace SurfEngine {
+
+	// Entities and components of one pool, in the pool's own order
+	template<typename Component>
+	struct SnapshotPool {
+		std::vector<entt::entity> Entities;
+		std::vector<Component> Components;
+	};
+
+	// Every authored component, SpriteRenderData is left out as the scene rebuilds it when sprites are added
+	struct SnapshotPools {
+		std::tuple<
+			SnapshotPool<TagComponent>,
+			SnapshotPool<TransformComponent>,
+			SnapshotPool<SpriteRendererComponent>,
+			SnapshotPool<TilemapComponent>,
+			SnapshotPool<ParticleEmitterComponent>,
+			SnapshotPool<TextComponent>,
+			SnapshotPool<LightComponent>,
+			SnapshotPool<CameraComponent>,
+			SnapshotPool<AnimationComponent>,
+			SnapshotPool<ScriptComponent>,
+			SnapshotPool<RigidbodyComponent>,
+			SnapshotPool<BoxColliderComponent>,
+			SnapshotPool<CircleColliderComponent>
+		> Pools;
+	};
+
+	//State that belongs to a running scene is dropped from the copy, play mode starts it again
+	template<typename Component>
+	static void DetachRuntime(Component&) {}
+
+	static void DetachRuntime(RigidbodyComponent& rb2d) { rb2d.RuntimeBody = nullptr; }
+	//The pool is updated in place, sharing it would bring the played particles back
+	static void DetachRuntime(ParticleEmitterComponent& pec) { pec.Pool = nullptr; }
+	static void DetachRuntime(ScriptComponent& sc) { sc.script_class_instance = nullptr; sc.fixed_update_method = nullptr; }
+
+	template<typename Component>
+	static void CapturePool(entt::registry& registry, SnapshotPool<Component>& pool) {
+		auto view = registry.view<Component>();
+		const entt::entity* entities = view.data();
+		pool.Entities.assign(entities, entities + view.size());
+		pool.Components.clear();
+		pool.Components.reserve(pool.Entities.size());
+		for (entt::entity entity : pool.Entities) {
+			pool.Components.push_back(view.template get<Component>(entity));
+			DetachRuntime(pool.Components.back());
+		}
+	}
+
+	//One bulk insert per pool, construction signals still fire so indices, groups and sprite data catch up
+	template<typename Component>
+	static void RestorePool(entt::registry& registry, const SnapshotPool<Component>& pool) {
+		registry.insert<Component>(pool.Entities.begin(), pool.Entities.end(), pool.Components.begin());
+	}
+
+	SceneSnapshot::SceneSnapshot()
+		: m_Pools(std::make_unique<SnapshotPools>())
+	{
+	}
+
+	SceneSnapshot::~SceneSnapshot() = default;
+
+	void SceneSnapshot::Capture(Scene& scene) {
+		entt::registry& registry = scene.m_Registry;
+		m_Scene = &scene;
+		m_Name = scene.m_name;
+		m_Entities.assign(registry.data(), registry.data() + registry.size());
+		m_Released = registry.released();
+		std::apply([&](auto&... pools) { (CapturePool(registry, pools), ...); }, m_Pools->Pools);
+
+		m_EntityMap = scene.m_EntityMap;
+		m_NameIndex = scene.m_NameIndex;
+		m_StaticLayers = scene.m_StaticLayers;
+	}
+
+	bool SceneSnapshot::Restore(Scene& scene) const {
+		if (m_Scene != &scene) {
+			SE_CORE_ERROR("Scene snapshot restored into a scene it was not taken from");
+			return false;
+		}
+
+		entt::registry& registry = scene.m_Registry;
+		registry.clear();
+		registry.assign(m_Entities.begin(), m_Entities.end(), m_Released);
+		std::apply([&](const auto&... pools) { (RestorePool(registry, pools), ...); }, m_Pools->Pools);
+
+		scene.m_name = m_Name;
+		scene.m_EntityMap = m_EntityMap;
+		scene.m_NameIndex = m_NameIndex;
+		//Views into the copied keys
+		scene.m_NameLookup.clear();
+		for (auto& [name, entities] : scene.m_NameIndex)
+			scene.m_NameLookup[std::string_view(name)] = &entities;
+		scene.m_StaticLayers = m_StaticLayers;
+		scene.MarkDirty();
+		return true;
+	}
+
+	void SceneSnapshot::Clear() {
+		m_Scene = nullptr;
+		m_Name.clear();
+		m_Entities.clear();
+		m_Released = entt::null;
+		m_Pools = std::make_unique<SnapshotPools>();
+		m_EntityMap.clear();
+		m_NameIndex.clear();
+		m_StaticLayers.clear();
+	}
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include "Scene.h"
+
+namespace SurfEngine {
+	struct SnapshotPools;
+
+	// In memory copy of a scene's objects, taken before play mode and restored after it instead of going through YAML
+	// Component storage is copied pool by pool and entity identifiers come back exactly as they were, so hierarchy
+	// links and the uuid and name indices need no remapping. Runtime state such as physics bodies is left out
+	class SceneSnapshot {
+	public:
+		SceneSnapshot();
+		~SceneSnapshot();
+
+		void Capture(Scene& scene);
+		// Only into the scene it was captured from, objects hold a pointer to their scene
+		bool Restore(Scene& scene) const;
+
+		bool IsEmpty() const { return m_Scene == nullptr; }
+		void Clear();
+	private:
+		const Scene* m_Scene = nullptr;
+		std::string m_Name;
+		std::vector<entt::entity> m_Entities;
+		entt::entity m_Released = entt::null;
+		Scope<SnapshotPools> m_Pools;
+
+		std::unordered_map<UUID, entt::entity> m_EntityMap;
+		std::map<std::string, std::vector<entt::entity>, std::less<>> m_NameIndex;
+		std::set<unsigned int> m_StaticLayers;
+	};
+}
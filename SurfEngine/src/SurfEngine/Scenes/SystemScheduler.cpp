@@ -0,0 +1,89 @@
+#include "sepch.h"
+#include "SystemScheduler.h"
+
+#include "SurfEngine/Core/JobSystem.h"
+#include <chrono>
+
+namespace SurfEngine {
+
+	static bool Overlaps(const std::vector<entt::id_type>& lhs, const std::vector<entt::id_type>& rhs) {
+		for (entt::id_type id : lhs) {
+			if (std::find(rhs.begin(), rhs.end(), id) != rhs.end())
+				return true;
+		}
+		return false;
+	}
+
+	//Readers only conflict with writers, main thread systems are already ordered by running on one thread
+	bool SystemScheduler::Access::ConflictsWith(const Access& other) const {
+		if (m_WritesAll || other.m_WritesAll)
+			return true;
+		return Overlaps(m_Writes, other.m_Writes) || Overlaps(m_Writes, other.m_Reads) || Overlaps(m_Reads, other.m_Writes);
+	}
+
+	void SystemScheduler::Add(const std::string& name, const Access& access, const System& system) {
+		const uint32_t index = (uint32_t)m_Systems.size();
+		Entry entry = { access, system, 0, {} };
+		for (uint32_t i = 0; i < index; i++) {
+			if (access.ConflictsWith(m_Systems[i].SystemAccess)) {
+				m_Systems[i].Dependents.push_back(index);
+				entry.DependencyCount++;
+			}
+		}
+		m_Systems.push_back(std::move(entry));
+		m_Timings.push_back({ name, 0.0f, access.IsMainThread() });
+	}
+
+	void SystemScheduler::Clear() {
+		m_Systems.clear();
+		m_Timings.clear();
+	}
+
+	static float MillisecondsSince(std::chrono::steady_clock::time_point start) {
+		return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	//Systems never wait inside a job, a worker waiting there could pick up a later system that needs it and stall both
+	//A worker system is queued once its last dependency finished, main thread systems run in order on the calling
+	//thread once theirs did, and nothing ever waits on a system that has not been handed out
+	void SystemScheduler::Run(Timestep ts) {
+		auto start = std::chrono::steady_clock::now();
+		const uint32_t count = (uint32_t)m_Systems.size();
+		// Dependencies each system still waits for
+		std::vector<JobSystem::Counter> pending(count);
+		for (uint32_t i = 0; i < count; i++)
+			pending[i].Pending.store(m_Systems[i].DependencyCount, std::memory_order_relaxed);
+		JobSystem::Counter done;
+
+		std::function<void(uint32_t)> runSystem;
+		auto submit = [&](uint32_t index) {
+			JobSystem::Run([&runSystem, index]() { runSystem(index); }, &done);
+		};
+		runSystem = [&](uint32_t index) {
+			Entry& entry = m_Systems[index];
+			auto systemStart = std::chrono::steady_clock::now();
+			entry.Function(ts);
+			m_Timings[index].Milliseconds = MillisecondsSince(systemStart);
+
+			//Dependents are queued before this job's own count drops, so done cannot reach zero early
+			for (uint32_t dependent : entry.Dependents) {
+				if (pending[dependent].Pending.fetch_sub(1, std::memory_order_acq_rel) == 1 && !m_Systems[dependent].SystemAccess.IsMainThread())
+					submit(dependent);
+			}
+		};
+
+		for (uint32_t i = 0; i < count; i++) {
+			if (!m_Systems[i].SystemAccess.IsMainThread() && m_Systems[i].DependencyCount == 0)
+				submit(i);
+		}
+		for (uint32_t i = 0; i < count; i++) {
+			if (!m_Systems[i].SystemAccess.IsMainThread())
+				continue;
+			JobSystem::Wait(pending[i]);
+			runSystem(i);
+		}
+		JobSystem::Wait(done);
+
+		m_RunTime = MillisecondsSince(start);
+	}
+}
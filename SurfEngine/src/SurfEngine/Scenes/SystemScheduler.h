@@ -0,0 +1,67 @@
+#pragma once
+#include "entt.hpp"
+#include "SurfEngine/Core/Timestep.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace SurfEngine {
+
+	// Scene update logic as systems that declare which components they read and write
+	// Every run is a dependency graph on the JobSystem, a system only waits for the earlier systems whose
+	// access conflicts with its own, so systems touching different components run side by side
+	class SystemScheduler {
+	public:
+		class Access {
+		public:
+			template<typename... Component>
+			Access& Read() { (m_Reads.push_back(entt::type_hash<Component>::value()), ...); return *this; }
+			template<typename... Component>
+			Access& Write() { (m_Writes.push_back(entt::type_hash<Component>::value()), ...); return *this; }
+			// For systems that call out to user code, they conflict with every other system
+			Access& WriteAll() { m_WritesAll = true; return *this; }
+			// Runs on the thread calling Run, for APIs bound to it such as the script runtime
+			Access& MainThread() { m_MainThread = true; return *this; }
+
+			bool ConflictsWith(const Access& other) const;
+			bool IsMainThread() const { return m_MainThread; }
+		private:
+			std::vector<entt::id_type> m_Reads;
+			std::vector<entt::id_type> m_Writes;
+			bool m_WritesAll = false;
+			bool m_MainThread = false;
+		};
+
+		struct Timing {
+			std::string Name;
+			// Time spent in the system itself, waiting for its dependencies not included
+			float Milliseconds = 0.0f;
+			bool MainThread = false;
+		};
+
+		using System = std::function<void(Timestep)>;
+	public:
+		// Systems whose access conflicts run in the order they were added
+		void Add(const std::string& name, const Access& access, const System& system);
+		void Clear();
+
+		// Returns once every system ran
+		void Run(Timestep ts);
+
+		// Per system times of the last run, and how long the whole run took
+		const std::vector<Timing>& GetTimings() const { return m_Timings; }
+		float GetRunTime() const { return m_RunTime; }
+	private:
+		struct Entry {
+			Access SystemAccess;
+			System Function;
+			// Earlier systems this one waits for, and the later ones waiting for it
+			uint32_t DependencyCount = 0;
+			std::vector<uint32_t> Dependents;
+		};
+		std::vector<Entry> m_Systems;
+		std::vector<Timing> m_Timings;
+		float m_RunTime = 0.0f;
+	};
+}
@@ -0,0 +1,159 @@
+#include "sepch.h"
+#include "TransformHierarchy.h"
+
+#include "Components.h"
+#include "SurfEngine/Core/JobSystem.h"
+#include <limits>
+
+namespace SurfEngine {
+
+	//Entries whose parent is not in the order, corrupt links are resolved through the component instead
+	static const int32_t s_Unordered = -2;
+	// Depths with fewer entries are updated on the calling thread
+	static const uint32_t s_ParallelGrain = 1024;
+
+	void TransformHierarchy::Connect(entt::registry& registry) {
+		registry.on_construct<TransformComponent>().connect<&TransformHierarchy::OnTransformChanged>(*this);
+		registry.on_destroy<TransformComponent>().connect<&TransformHierarchy::OnTransformChanged>(*this);
+		m_Valid = false;
+	}
+
+	void TransformHierarchy::Rebuild(entt::registry& registry) {
+		auto view = registry.view<TransformComponent>();
+		m_Entities.clear();
+		m_Parents.clear();
+		m_DepthOffsets.clear();
+
+		std::unordered_set<entt::entity> visited;
+		auto add = [&](entt::entity entity, int32_t parent) {
+			if (!visited.insert(entity).second)
+				return;
+			m_Entities.push_back(entity);
+			m_Parents.push_back(parent);
+		};
+
+		//Roots, then each depth from the children of the one before
+		for (auto entity : view) {
+			if (view.get<TransformComponent>(entity).Parent == entt::null)
+				add(entity, -1);
+		}
+		m_DepthOffsets.push_back(0);
+		uint32_t begin = 0;
+		while (begin < (uint32_t)m_Entities.size()) {
+			uint32_t end = (uint32_t)m_Entities.size();
+			m_DepthOffsets.push_back(end);
+			for (uint32_t i = begin; i < end; i++) {
+				entt::entity child = view.get<TransformComponent>(m_Entities[i]).FirstChild;
+				for (; child != entt::null; child = view.get<TransformComponent>(child).NextSibling)
+					add(child, (int32_t)i);
+			}
+			begin = end;
+		}
+
+		//Parents that do not list the child, or cycles, never get reached from a root
+		for (auto entity : view)
+			add(entity, s_Unordered);
+
+		const size_t count = m_Entities.size();
+		m_LocalAngle.assign(count, std::numeric_limits<float>::quiet_NaN());
+		m_LocalCos.assign(count, 1.0f);
+		m_LocalSin.assign(count, 0.0f);
+		for (auto* array : { &m_PositionX, &m_PositionY, &m_PositionZ, &m_Cos, &m_Sin, &m_ScaleX, &m_ScaleY, &m_ScaleZ })
+			array->resize(count);
+
+		m_Stats.Transforms = (uint32_t)count;
+		m_Stats.Depth = (uint32_t)m_DepthOffsets.size() - 1;
+		m_Stats.Rebuilds++;
+		m_Valid = true;
+	}
+
+	void TransformHierarchy::StoreWorld(uint32_t index, const WorldTransform& world) {
+		m_PositionX[index] = world.Position.x; m_PositionY[index] = world.Position.y; m_PositionZ[index] = world.Position.z;
+		m_Cos[index] = world.Rotation.x; m_Sin[index] = world.Rotation.y;
+		m_ScaleX[index] = world.Scale.x; m_ScaleY[index] = world.Scale.y; m_ScaleZ[index] = world.Scale.z;
+	}
+
+	void TransformHierarchy::Update(entt::registry& registry) {
+		if (!m_Valid)
+			Rebuild(registry);
+
+		//Entries done before a moved parent was found are clean by then, the second pass only copies them
+		m_Stats.Updated = 0;
+		if (!UpdateOrdered(registry)) {
+			Rebuild(registry);
+			UpdateOrdered(registry);
+		}
+
+		//Entries outside the order go through the component
+		auto view = registry.view<TransformComponent>();
+		for (uint32_t i = m_DepthOffsets.back(); i < (uint32_t)m_Entities.size(); i++)
+			StoreWorld(i, view.get<TransformComponent>(m_Entities[i]).GetWorld());
+	}
+
+	bool TransformHierarchy::UpdateOrdered(entt::registry& registry) {
+		auto view = registry.view<TransformComponent>();
+		std::atomic<uint32_t> updated{ 0 };
+		std::atomic<bool> moved{ false };
+
+		//Entries only read the depth above them, so every depth is split across the job system's workers
+		for (size_t depth = 0; depth + 1 < m_DepthOffsets.size() && !moved; depth++) {
+			const uint32_t first = m_DepthOffsets[depth];
+			JobSystem::ParallelFor(m_DepthOffsets[depth + 1] - first, s_ParallelGrain, [&](uint32_t begin, uint32_t end) {
+				uint32_t count = 0;
+				for (uint32_t i = first + begin; i < first + end; i++) {
+					TransformComponent& tc = view.get<TransformComponent>(m_Entities[i]);
+					int32_t parent = m_Parents[i];
+
+					//A parent changed since the order was built
+					entt::entity expectedParent = parent >= 0 ? m_Entities[parent] : entt::null;
+					if (expectedParent != tc.Parent) {
+						moved = true;
+						continue;
+					}
+
+					//Clean entries were read or updated since they last changed, their cache is current
+					if (!tc.m_Dirty) {
+						StoreWorld(i, tc.m_World);
+						continue;
+					}
+
+					float angle = tc.Rotation.z;
+					if (angle != m_LocalAngle[i]) {
+						float radians = glm::radians(angle);
+						m_LocalAngle[i] = angle;
+						m_LocalCos[i] = std::cos(radians);
+						m_LocalSin[i] = std::sin(radians);
+					}
+
+					float parentX = 0.0f, parentY = 0.0f, parentZ = 0.0f;
+					float parentCos = 1.0f, parentSin = 0.0f;
+					float parentScaleX = 1.0f, parentScaleY = 1.0f, parentScaleZ = 1.0f;
+					if (parent >= 0) {
+						parentX = m_PositionX[parent]; parentY = m_PositionY[parent]; parentZ = m_PositionZ[parent];
+						parentCos = m_Cos[parent]; parentSin = m_Sin[parent];
+						parentScaleX = m_ScaleX[parent]; parentScaleY = m_ScaleY[parent]; parentScaleZ = m_ScaleZ[parent];
+					}
+
+					const glm::vec3& translation = tc.Translation;
+					m_PositionX[i] = parentX + parentCos * translation.x - parentSin * translation.y;
+					m_PositionY[i] = parentY + parentSin * translation.x + parentCos * translation.y;
+					m_PositionZ[i] = parentZ + translation.z;
+					m_Cos[i] = parentCos * m_LocalCos[i] - parentSin * m_LocalSin[i];
+					m_Sin[i] = parentSin * m_LocalCos[i] + parentCos * m_LocalSin[i];
+					m_ScaleX[i] = parentScaleX * tc.Scale.x;
+					m_ScaleY[i] = parentScaleY * tc.Scale.y;
+					m_ScaleZ[i] = parentScaleZ * tc.Scale.z;
+
+					tc.m_World.Position = { m_PositionX[i], m_PositionY[i], m_PositionZ[i] };
+					tc.m_World.Rotation = { m_Cos[i], m_Sin[i] };
+					tc.m_World.Scale = { m_ScaleX[i], m_ScaleY[i], m_ScaleZ[i] };
+					tc.m_Dirty = false;
+					count++;
+				}
+				updated += count;
+			});
+		}
+		m_Stats.Updated += updated;
+		return !moved;
+	}
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include "entt.hpp"
+#include <vector>
+
+namespace SurfEngine {
+	struct WorldTransform;
+
+	// Flattened copy of the transform hierarchy, breadth first so every parent comes before its children
+	// and each depth is one contiguous range. World transforms are kept in structure of arrays form and
+	// updated in one linear pass, each entry reading the already updated entry of its parent
+	// Large depths are split across the JobSystem workers
+	// The order is rebuilt when transforms are added or removed or a parent changes
+	class TransformHierarchy {
+	public:
+		struct Statistics {
+			uint32_t Transforms = 0;
+			uint32_t Depth = 0;
+			// Entries whose world transform was recomputed in the last update
+			uint32_t Updated = 0;
+			uint32_t Rebuilds = 0;
+		};
+	public:
+		// Hooks the registry's transform construction and destruction, both invalidate the order
+		void Connect(entt::registry& registry);
+		void Invalidate() { m_Valid = false; }
+
+		// Brings every cached world transform up to date
+		void Update(entt::registry& registry);
+
+		const Statistics& GetStats() const { return m_Stats; }
+	private:
+		void Rebuild(entt::registry& registry);
+		// False when a parent changed since the order was built, the pass stops after that depth
+		bool UpdateOrdered(entt::registry& registry);
+		void StoreWorld(uint32_t index, const WorldTransform& world);
+		void OnTransformChanged(entt::registry&, entt::entity) { m_Valid = false; }
+	private:
+		bool m_Valid = false;
+		std::vector<entt::entity> m_Entities;
+		// Index of the parent entry, -1 for roots
+		std::vector<int32_t> m_Parents;
+		// First entry of every depth, plus the end
+		std::vector<uint32_t> m_DepthOffsets;
+
+		// Local rotation angle and its cosine and sine, recomputed only when the angle changes
+		std::vector<float> m_LocalAngle;
+		std::vector<float> m_LocalCos, m_LocalSin;
+
+		// World transforms
+		std::vector<float> m_PositionX, m_PositionY, m_PositionZ;
+		std::vector<float> m_Cos, m_Sin;
+		std::vector<float> m_ScaleX, m_ScaleY, m_ScaleZ;
+
+		Statistics m_Stats;
+	};
+}
@@ -35,6 +35,9 @@ namespace SurfEngine {
 		if (std::strcmp(component_type_str, "Animation") == 0) {
 			return o.HasComponent<AnimationComponent>();
 		}
+		if (std::strcmp(component_type_str, "Text") == 0) {
+			return o.HasComponent<TextComponent>();
+		}
 		if (std::strcmp(component_type_str, "Rigidbody") == 0) {
 			return o.HasComponent<RigidbodyComponent>();
 		}
@@ -89,6 +92,7 @@ namespace SurfEngine {
 		tc.Translation.x = (float)x;
 		tc.Translation.y = (float)-y;
 		tc.Translation.z = (float)z;
+		tc.MarkDirty();
 	}
 
 	void TranslateX(MonoString* msg, double x)
@@ -98,6 +102,7 @@ namespace SurfEngine {
 		Object o = current_scene->GetObjectByUUID(UUID(uuid));
 		auto& tc = o.GetComponent<TransformComponent>();
 		tc.Translation.x += (float)x;
+		tc.MarkDirty();
 	}
 
 	void TranslateY(MonoString* msg, double y)
@@ -107,6 +112,7 @@ namespace SurfEngine {
 		Object o = current_scene->GetObjectByUUID(UUID(uuid));
 		auto& tc = o.GetComponent<TransformComponent>();
 		tc.Translation.y -= (float)y;
+		tc.MarkDirty();
 	}
 
 	//Rotation
@@ -124,6 +130,7 @@ namespace SurfEngine {
 		Object o = current_scene->GetObjectByUUID(UUID(uuid));
 		auto& tc = o.GetComponent<TransformComponent>();
 		tc.Rotation.z = (float)new_rot;
+		tc.MarkDirty();
 	}
 
 
@@ -134,6 +141,7 @@ namespace SurfEngine {
 		Object o = current_scene->GetObjectByUUID(UUID(uuid));
 		auto& tc = o.GetComponent<TransformComponent>();
 		tc.Rotation.z += (float)z;
+		tc.MarkDirty();
 	}
 
 	//Scale
@@ -159,6 +167,7 @@ namespace SurfEngine {
 		tc.Scale.x = (float)x;
 		tc.Scale.y = (float)y;
 		tc.Scale.z = (float)z;
+		tc.MarkDirty();
 	}
 
 	void ScaleX(MonoString* msg, double x)
@@ -168,6 +177,7 @@ namespace SurfEngine {
 		Object o = current_scene->GetObjectByUUID(UUID(uuid));
 		auto& tc = o.GetComponent<TransformComponent>();
 		tc.Scale.x += (float)x;
+		tc.MarkDirty();
 	}
 
 	void ScaleY(MonoString* msg, double y)
@@ -177,6 +187,7 @@ namespace SurfEngine {
 		Object o = current_scene->GetObjectByUUID(UUID(uuid));
 		auto& tc = o.GetComponent<TransformComponent>();
 		tc.Scale.y += (float)y;
+		tc.MarkDirty();
 	}
 
 	MonoArray* GetColorImpl(MonoString* msg) {
@@ -203,6 +214,7 @@ namespace SurfEngine {
 		src.Color.g = (float)g;
 		src.Color.b = (float)b;
 		src.Color.a = (float)a;
+		current_scene->UpdateSpriteRenderData(o);
 	}
 
 	double GetLayerImpl(MonoString* msg) {
@@ -220,6 +232,7 @@ namespace SurfEngine {
 		Object o = current_scene->GetObjectByUUID(UUID(uuid));
 		auto& src = o.GetComponent<SpriteRendererComponent>();
 		src.Layer = (unsigned int)layer;
+		current_scene->UpdateSpriteRenderData(o);
 	}
 
 	//Sprite Renderer
@@ -230,6 +243,7 @@ namespace SurfEngine {
 		Object o = current_scene->GetObjectByUUID(UUID(uuid));
 		auto& sr = o.GetComponent<SpriteRendererComponent>();
 		sr.flipX = flipX;
+		current_scene->UpdateSpriteRenderData(o);
 	}
 
 	MonoString* GetGameObjectByName(MonoString* name)
@@ -437,7 +451,7 @@ namespace SurfEngine {
 		uint64_t uuid = std::stoull(str);
 		Object o = current_scene->GetObjectByUUID(UUID(uuid));
 		auto& ac = o.GetComponent<AnimationComponent>();
-		return ac.currframe;
+		return ac.GetFrame(current_scene->GetTime());
 	}
 
 	void AnimationSetFrameImpl(MonoString* msg, unsigned int frame) {
@@ -445,7 +459,7 @@ namespace SurfEngine {
 		uint64_t uuid = std::stoull(str);
 		Object o = current_scene->GetObjectByUUID(UUID(uuid));
 		auto& ac = o.GetComponent<AnimationComponent>();
-		ac.currframe = frame;
+		ac.SetFrame(frame, current_scene->GetTime());
 	}
 
 	void AnimationPlayImpl(MonoString* msg) {
@@ -453,7 +467,7 @@ namespace SurfEngine {
 		uint64_t uuid = std::stoull(str);
 		Object o = current_scene->GetObjectByUUID(UUID(uuid));
 		auto& ac = o.GetComponent<AnimationComponent>();
-		ac.play = true;
+		ac.Play(current_scene->GetTime());
 	}
 
 	void AnimationStopImpl(MonoString* msg) {
@@ -461,7 +475,25 @@ namespace SurfEngine {
 		uint64_t uuid = std::stoull(str);
 		Object o = current_scene->GetObjectByUUID(UUID(uuid));
 		auto& ac = o.GetComponent<AnimationComponent>();
-		ac.play = false;
+		ac.Stop(current_scene->GetTime());
+	}
+
+	MonoString* TextGetImpl(MonoString* msg) {
+		char* str = mono_string_to_utf8(msg);
+		uint64_t uuid = std::stoull(str);
+		Object o = current_scene->GetObjectByUUID(UUID(uuid));
+		auto& tc = o.GetComponent<TextComponent>();
+		return mono_string_new(mono_domain_get(), tc.Text.c_str());
+	}
+
+	void TextSetImpl(MonoString* msg, MonoString* text) {
+		char* str = mono_string_to_utf8(msg);
+		uint64_t uuid = std::stoull(str);
+		Object o = current_scene->GetObjectByUUID(UUID(uuid));
+		auto& tc = o.GetComponent<TextComponent>();
+		char* text_str = mono_string_to_utf8(text);
+		tc.Text = text_str;
+		mono_free(text_str);
 	}
 
 	static void InitScriptFuncs() {
@@ -529,6 +561,10 @@ namespace SurfEngine {
 		mono_add_internal_call("SurfEngine.Animation::GetFrameImpl", &AnimationGetFrameImpl);
 		mono_add_internal_call("SurfEngine.Animation::SetFrameImpl", &AnimationSetFrameImpl);
 
+		//Text
+		mono_add_internal_call("SurfEngine.Text::GetTextImpl", &TextGetImpl);
+		mono_add_internal_call("SurfEngine.Text::SetTextImpl", &TextSetImpl);
+
 		//Input
 		mono_add_internal_call("SurfEngine.Input::GetKeyDownImpl", &GetKeyDown);
 